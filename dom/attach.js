@@ -0,0 +1,112 @@
+const harness = typeof require === 'function' ? require('../harness/bench') : { Bench, report, toJSON, now }
+const htmlElement = typeof require === 'function' ? require('./htmlelement') : { prepare, create, modify }
+
+/**
+ * create() 出来的元素从没插进文档，5000个元素的数字不含插入、样式和布局。
+ * 这里把它们插进 document.body 下的容器(逐个 appendChild、先放进 DocumentFragment、replaceChildren)，
+ * 再用几种方式移除，分别计时；metrics 里的 recalc 是操作之后强制样式计算+布局的耗时。
+ *
+ * @author KotoriK
+ */
+function testAttach(testUrl) {
+    const bench = new harness.Bench('dom/attach', DEFAULTS)
+    return htmlElement.prepare({ url: testUrl }).then((context) => {
+        register(bench, context)
+        return bench.run()
+    }).then((results) => {
+        harness.report(results)
+        return harness.toJSON('dom/attach', results)
+    })
+}
+
+const DEFAULTS = { n: 5000, samples: 20 }
+
+// 读一次计算样式和尺寸，逼浏览器把挂起的样式计算和布局做完
+function recalc(state) {
+    const start = harness.now()
+    getComputedStyle(state.container.lastChild || state.container).display
+    void state.container.offsetHeight
+    return { recalc: harness.now() - start }
+}
+
+function setup(eleNum, url, attached) {
+    const array = [],
+        container = document.createElement('div')
+    htmlElement.create(array, eleNum)
+    htmlElement.modify(array, url)
+    document.body.appendChild(container)
+    if (attached) {
+        for (const el of array) {
+            container.appendChild(el)
+        }
+        void container.offsetHeight
+    }
+    return { array, container }
+}
+
+function teardown(state) {
+    state.container.remove()
+}
+
+function register(bench, context) {
+    const url = context.url
+    const inserts = {
+        'append individually'(state) {
+            for (const el of state.array) {
+                state.container.appendChild(el)
+            }
+        },
+        'append fragment'(state) {
+            const fragment = document.createDocumentFragment()
+            for (const el of state.array) {
+                fragment.appendChild(el)
+            }
+            state.container.appendChild(fragment)
+        },
+        'replaceChildren'(state) {
+            state.container.replaceChildren(...state.array)
+        },
+    }
+    for (const name in inserts) {
+        bench.add(name, {
+            setup: eleNum => setup(eleNum, url, false),
+            run(state) {
+                inserts[name](state)
+                return state
+            },
+            metrics: recalc,
+            teardown
+        })
+    }
+    const removes = {
+        'remove individually'(state) {
+            for (const el of state.array) {
+                el.remove()
+            }
+        },
+        'remove replaceChildren()'(state) {
+            state.container.replaceChildren()
+        },
+        'remove textContent'(state) {
+            state.container.textContent = ''
+        },
+        'remove container'(state) {
+            state.container.remove()
+        },
+    }
+    for (const name in removes) {
+        bench.add(name, {
+            setup: eleNum => setup(eleNum, url, true),
+            run(state) {
+                removes[name](state)
+                return state
+            },
+            metrics: recalc,
+            teardown
+        })
+    }
+}
+
+if (typeof module !== 'undefined') {
+    module.exports = { needsDOM: true, defaults: DEFAULTS, prepare: htmlElement.prepare, testAttach, register }
+}
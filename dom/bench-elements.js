@@ -0,0 +1,89 @@
+/**
+ * dom/ 下几个套件共用的自定义元素。浏览器里同名元素只能 define 一次，所以集中在这里定义，
+ * 粘贴进控制台时先粘贴本文件。
+ * ce-plain 没有构造函数；ce-light/ce-heavy 的构造函数分别做少量和较多的工作(字段、绑定监听器)；
+ * ce-shadow-html/ce-shadow-template 在构造函数里建 shadow DOM；ce-player 把 audio 包在 shadow 里；
+ * ce-connected 在 connectedCallback/disconnectedCallback 里做事。
+ *
+ * @author KotoriK
+ */
+const SHADOW_HTML = '<style>:host{display:inline-block}</style><button part="play"></button><slot></slot>'
+
+/**
+ * 注册全部元素，已经注册过就跳过(重复调用、在浏览器控制台里重复运行时)。
+ * 要用到 customElements 和 document，放在用例的 setup 里调用，register 时还不一定有 DOM
+ */
+function defineElements() {
+    if (customElements.get('ce-plain')) return
+    customElements.define('ce-plain', class extends HTMLElement { })
+    customElements.define('ce-light', class extends HTMLElement {
+        constructor() {
+            super()
+            this.volume = 1
+            this.muted = false
+        }
+    })
+    customElements.define('ce-heavy', class extends HTMLElement {
+        constructor() {
+            super()
+            this.state = { volume: 1, muted: false, position: 0, duration: NaN, rate: 1 }
+            this.queue = []
+            this.handlers = {}
+            for (const type of ['click', 'keydown', 'pointerdown', 'pointerup', 'focus', 'blur']) {
+                this.handlers[type] = this.handle.bind(this, type)
+                this.addEventListener(type, this.handlers[type])
+            }
+        }
+
+        handle(type) {
+            this.queue.push(type)
+        }
+    })
+    customElements.define('ce-shadow-html', class extends HTMLElement {
+        constructor() {
+            super()
+            this.attachShadow({ mode: 'open' }).innerHTML = SHADOW_HTML
+        }
+    })
+    const template = document.createElement('template')
+    template.innerHTML = SHADOW_HTML
+    customElements.define('ce-shadow-template', class extends HTMLElement {
+        constructor() {
+            super()
+            this.attachShadow({ mode: 'open' }).appendChild(template.content.cloneNode(true))
+        }
+    })
+    // 包了一个 audio 的播放器，src 转发给里面的 audio
+    customElements.define('ce-player', class extends HTMLElement {
+        constructor() {
+            super()
+            this.audio = document.createElement('audio')
+            this.attachShadow({ mode: 'open' }).appendChild(this.audio)
+        }
+
+        get src() {
+            return this.audio.src
+        }
+
+        set src(value) {
+            this.audio.src = value
+        }
+    })
+    customElements.define('ce-connected', class extends HTMLElement {
+        connectedCallback() {
+            this.setAttribute('role', 'button')
+            this.tabIndex = 0
+            this.controller = new AbortController()
+            this.addEventListener('click', () => { }, { signal: this.controller.signal })
+        }
+
+        disconnectedCallback() {
+            this.controller.abort()
+            this.controller = null
+        }
+    })
+}
+
+if (typeof module !== 'undefined') {
+    module.exports = { defineElements, SHADOW_HTML }
+}
@@ -0,0 +1,94 @@
+const harness = typeof require === 'function' ? require('../harness/bench') : { Bench, report, toJSON, now }
+const htmlElement = typeof require === 'function' ? require('./htmlelement') : { prepare, create, modify }
+const benchElements = typeof require === 'function' ? require('./bench-elements') : { defineElements }
+
+/**
+ * 自定义元素(customElements.define 的自主元素)的构造开销，和直接 createElement('audio') 比。
+ * 每轮一批 5000 个：构造函数里做不同量的工作、attachShadow(innerHTML 还是克隆模板)、
+ * 把 audio 包进组件的播放器，以及插进文档时 connectedCallback/disconnectedCallback 的开销。
+ * 用来判断把播放器包成 web component 会多花多少。
+ *
+ * @author KotoriK
+ */
+function testCustomElement(testUrl) {
+    const bench = new harness.Bench('dom/custom-element', DEFAULTS)
+    return htmlElement.prepare({ url: testUrl }).then((context) => {
+        register(bench, context)
+        return bench.run()
+    }).then((results) => {
+        harness.report(results)
+        return harness.toJSON('dom/custom-element', results)
+    })
+}
+
+const DEFAULTS = { n: 5000, samples: 20 }
+
+function createBatch(tagName, eleNum) {
+    const array = []
+    htmlElement.create(array, eleNum, tagName)
+    return array
+}
+
+function setupAttach(tagName, eleNum) {
+    benchElements.defineElements()
+    const container = document.createElement('div')
+    document.body.appendChild(container)
+    return { array: createBatch(tagName, eleNum), container }
+}
+
+function register(bench, context) {
+    const url = context.url
+    //元素都在 setup 里注册(dom/bench-elements.js)，register 时还不一定有 DOM
+    //构造: 同一批数量，不同的构造工作量
+    const tags = ['audio', 'ce-plain', 'ce-light', 'ce-heavy', 'ce-shadow-html', 'ce-shadow-template', 'ce-player']
+    for (const tagName of tags) {
+        bench.add(`create <${tagName}>`, {
+            setup: benchElements.defineElements,
+            run: (_, eleNum) => createBatch(tagName, eleNum)
+        })
+    }
+    //包进组件的播放器 vs 裸 audio: 创建并设置 src
+    for (const tagName of ['audio', 'ce-player']) {
+        bench.add(`create+modify <${tagName}>`, {
+            setup: benchElements.defineElements,
+            run(_, eleNum) {
+                const array = createBatch(tagName, eleNum)
+                htmlElement.modify(array, url)
+                return array
+            }
+        })
+    }
+    //插入/移除文档: connectedCallback/disconnectedCallback 的开销
+    for (const tagName of ['audio', 'ce-plain', 'ce-connected']) {
+        bench.add(`connect <${tagName}>`, {
+            setup: eleNum => setupAttach(tagName, eleNum),
+            run(state) {
+                for (const el of state.array) {
+                    state.container.appendChild(el)
+                }
+                return state
+            },
+            teardown: state => state.container.remove()
+        })
+        bench.add(`disconnect <${tagName}>`, {
+            setup(eleNum) {
+                const state = setupAttach(tagName, eleNum)
+                for (const el of state.array) {
+                    state.container.appendChild(el)
+                }
+                return state
+            },
+            run(state) {
+                for (const el of state.array) {
+                    el.remove()
+                }
+                return state
+            },
+            teardown: state => state.container.remove()
+        })
+    }
+}
+
+if (typeof module !== 'undefined') {
+    module.exports = { needsDOM: true, defaults: DEFAULTS, prepare: htmlElement.prepare, testCustomElement, register }
+}
@@ -0,0 +1,125 @@
+const harness = typeof require === 'function' ? require('../harness/bench') : { Bench, report, toJSON, now }
+
+/**
+ * 测 fetch → response.blob() → URL.createObjectURL 这条链路每一段的耗时：拿到响应头、读完整个 blob、生成 object URL，
+ * 以及不攒 blob、直接用 response.body 的 reader 流式读完的耗时。每种大小各测一组。
+ * 资源大小用 ?size= 向本地静态服务要(harness/run.js 会起)，在浏览器里则用内存里生成的 blob URL 代替。
+ *
+ * @author KotoriK
+ * @param {string} [testUrl] 额外测一下这个地址
+ * @param {number[]} [sizes]
+ */
+function testFetch(testUrl, sizes) {
+    const bench = new harness.Bench('dom/fetch-blob', DEFAULTS)
+    return prepare({ url: testUrl, sizes: sizes && sizes.join(',') }).then((context) => {
+        register(bench, context)
+        return bench.run()
+    }).then((results) => {
+        harness.report(results)
+        return harness.toJSON('dom/fetch-blob', results)
+    })
+}
+
+const DEFAULTS = { n: 1000, samples: 20, warmup: 2 }
+const SIZES = [1 << 10, 1 << 16, 1 << 20, 1 << 24]
+
+/**
+ * 依次执行链路的三段，分别计时
+ *
+ * @param {string} url
+ */
+async function fetchStages(url) {
+    const t0 = harness.now()
+    const response = await fetch(url, {
+        method: 'get'
+    })
+    const t1 = harness.now()
+    const blob = await response.blob()
+    const t2 = harness.now()
+    const objectURL = URL.createObjectURL(blob)
+    const t3 = harness.now()
+    return {
+        objectURL,
+        blob,
+        stages: { headers: t1 - t0, body: t2 - t1, objectURL: t3 - t2, total: t3 - t0 }
+    }
+}
+
+function prepare(args) {
+    const sizes = args.sizes ? String(args.sizes).split(',').map(Number) : SIZES
+    const sources = sizes.map((size) => ({
+        label: formatSize(size),
+        url: args.sizable ? `${args.url}?size=${size}` : URL.createObjectURL(new Blob([new Uint8Array(size)]))
+    }))
+    if (args.url && !args.sizable) sources.push({ label: 'testUrl', url: args.url })
+    return Promise.resolve({ sources })
+}
+
+function cleanup(context) {
+    for (const s of context.sources) {
+        if (s.url.startsWith('blob:')) URL.revokeObjectURL(s.url)
+    }
+}
+
+function formatSize(bytes) {
+    return bytes >= 1 << 20 ? (bytes >> 20) + 'MB' : bytes >= 1 << 10 ? (bytes >> 10) + 'KB' : bytes + 'B'
+}
+
+// 没读的响应体要取消掉，不然连接一直占着
+function discard(response) {
+    if (response.body && !response.bodyUsed) return response.body.cancel()
+}
+
+// 资源地址来自 prepare；没有 prepare 过的 context(比如只想看用例名)就什么都不注册
+function register(bench, context) {
+    for (const { label, url } of context.sources || []) {
+        bench.add(`fetch headers ${label}`, {
+            run: () => fetch(url),
+            teardown: (_, response) => discard(response)
+        }, { n: 1 })
+        bench.add(`response.blob ${label}`, {
+            setup: () => fetch(url),
+            run: response => response.blob()
+        }, { n: 1 })
+        bench.add(`createObjectURL ${label}`, {
+            setup: () => fetch(url).then(response => response.blob()),
+            run(blob, times) {
+                const urls = []
+                for (let i = 0; i < times; i++) {
+                    urls.push(URL.createObjectURL(blob))
+                }
+                return urls
+            },
+            teardown(_, urls) {
+                for (const u of urls) URL.revokeObjectURL(u)
+            }
+        })
+        bench.add(`stream read ${label}`, {
+            setup: () => fetch(url),
+            run: response => readStream(response)
+        }, { n: 1 })
+        bench.add(`fetch→blob→objectURL ${label}`, {
+            run: () => fetchStages(url),
+            teardown: (_, r) => URL.revokeObjectURL(r.objectURL)
+        }, { n: 1 })
+    }
+}
+
+/**
+ * 用 reader 一块块读完，只统计字节数，不把数据拼起来
+ *
+ * @param {Response} response
+ */
+async function readStream(response) {
+    const reader = response.body.getReader()
+    let bytes = 0
+    for (;;) {
+        const { done, value } = await reader.read()
+        if (done) return bytes
+        bytes += value.byteLength
+    }
+}
+
+if (typeof module !== 'undefined') {
+    module.exports = { needsServer: true, defaults: DEFAULTS, testFetch, fetchStages, prepare, cleanup, register, readStream }
+}
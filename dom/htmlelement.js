@@ -1,51 +1,263 @@
+const harness = typeof require === 'function' ? require('../harness/bench') : { Bench, report, toJSON, now, heapUsed }
+const elementPool = typeof require === 'function' ? require('../lib/element-pool') : { ElementPool }
+const fetchBlob = typeof require === 'function' ? require('./fetch-blob') : { fetchStages }
+const benchElements = typeof require === 'function' ? require('./bench-elements') : { defineElements }
+
 /**
  * 测试创建AudioElement，修改他们的属性，以及删除他们所需要的时间。应该看第一个属性就够了，就是创建HTMLElement是真的开销很大
  *
+ * 要反复创建的话可以用 lib/element-pool.js 复用元素，对比见 acquire→modify→release
+ * 换成其他元素的对比见 <tag> 结尾的那组用例(video/img/div/span/自定义元素)，能看出多少开销是媒体元素特有的。
+ * 浏览器里运行时先粘贴 dom/bench-elements.js
+ * 不开浏览器离线跑(DOM 替身+本地静态服务): node harness/run.js dom/htmlelement.js
+ *
  * @author KotoriK
  */
 function startTest(testUrl) {
-    fetch(testUrl, {
-            method: 'get'
-        })
-        .then(async (response) => {
-            return URL.createObjectURL(await response.blob())
-        }).then((url) => {
-            var array = []
-            console.time('create')
-            create(array, 5000)
-            console.timeEnd('create')
-            console.time('modify')
-            modify(array, url)
-            console.timeEnd('modify')
-            let array2 = [...array]
-            console.time('deleteGC')
+    return prepare({ url: testUrl }).then((context) => {
+        const bench = new harness.Bench('dom/htmlelement', { n: 5000 })
+        register(bench, context)
+        return bench.run()
+    }).then((results) => {
+        harness.report(results)
+        return harness.toJSON('dom/htmlelement', results)
+    })
+}
 
-            deleteGC(array)
-            console.timeEnd('deleteGC')
+/**
+ * 下载测试用的资源，转成 object URL。链路各段的耗时放在 context.fetch 里，不打印(要测它见 dom/fetch-blob.js)
+ *
+ * @param {{url: string}} args
+ */
+function prepare(args) {
+    return fetchBlob.fetchStages(args.url).then(({ objectURL, stages }) => {
+        return { url: objectURL, fetch: stages }
+    })
+}
 
-            console.time('deleteNull')
-            deleteNull(array2)
-            console.timeEnd('deleteNull')
+function register(bench, context) {
+    const url = context.url
+    bench.add('create', eleNum => {
+        const array = []
+        create(array, eleNum)
+        return array
+    })
+    //其他创建方式，看每个元素的成本
+    bench.add('create cloneNode', eleNum => {
+        const array = []
+        createByClone(array, eleNum)
+        return array
+    })
+    bench.add('create template', eleNum => {
+        const array = []
+        createByTemplate(array, eleNum)
+        return array
+    })
+    bench.add('create fragment', eleNum => {
+        const array = []
+        createByFragment(array, eleNum)
+        return array
+    })
+    bench.add('create innerHTML', eleNum => {
+        const array = []
+        createByHTML(array, eleNum)
+        return array
+    })
+    bench.add('modify', {
+        setup(eleNum) {
+            const array = []
+            create(array, eleNum)
+            return array
+        },
+        run(array) {
+            modify(array, url)
+            return array
+        }
+    })
+    //删除: 清空数组的几种写法。metrics 里的 gcTime/freed 是清空后强制GC一次的耗时和回收的字节，
+    //需要 node --expose-gc 或 Chrome --js-flags=--expose-gc，否则为 NaN。
+    //setup 等 src 触发的加载事件派发完，正在加载的媒体元素不会被回收
+    const deletes = { deleteGC, deleteNull, deleteLength, deleteSplice }
+    for (const name in deletes) {
+        bench.add(name, {
+            setup: eleNum => settled(createModified(eleNum, url)),
+            run(array) {
+                deletes[name](array)
+                return array
+            },
+            metrics: reclaim
+        })
+    }
+    bench.add('deleteReassign', {
+        setup: eleNum => settled({ array: createModified(eleNum, url) }),
+        run(holder) {
+            deleteReassign(holder)
+            return holder
+        },
+        metrics: reclaim
+    })
+    //对象池: 稳态下池子常驻，每轮全部借出再归还；突发时池子只预留1/10，其余现建
+    let steady
+    bench.add('create→modify→discard', eleNum => {
+        const array = []
+        create(array, eleNum)
+        modify(array, url)
+        array.length = 0
+        return array
+    })
+    bench.add('acquire→modify→release', {
+        setup(eleNum) {
+            if (!steady) steady = new elementPool.ElementPool('audio', { size: eleNum })
+            return steady
+        },
+        run: (pool, eleNum) => cycle(pool, eleNum, url)
+    })
+    bench.add('burst acquire→modify→release', {
+        setup: eleNum => new elementPool.ElementPool('audio', { size: eleNum / 10 }),
+        run: (pool, eleNum) => cycle(pool, eleNum, url)
+    })
+    //元素类型矩阵: 同样的 创建/修改/清空/池化 换成不同的元素，audio 那一行就是上面不带 <tag> 的用例。
+    //自定义元素在 setup 里注册，register 时还不一定有 DOM
+    const pools = new Map()
+    for (const tagName of TAGS) {
+        const tag = `<${tagName}>`,
+            prop = SRC_TAGS.has(tagName) ? 'src' : 'title'
+        bench.add(`create ${tag}`, {
+            setup: benchElements.defineElements,
+            run(_, eleNum) {
+                const array = []
+                create(array, eleNum, tagName)
+                return array
+            }
+        })
+        bench.add(`modify ${tag}`, {
+            setup(eleNum) {
+                benchElements.defineElements()
+                const array = []
+                create(array, eleNum, tagName)
+                return array
+            },
+            run(array) {
+                modify(array, url, prop)
+                return array
+            }
+        })
+        bench.add(`deleteLength ${tag}`, {
+            setup(eleNum) {
+                benchElements.defineElements()
+                const array = []
+                create(array, eleNum, tagName)
+                modify(array, url, prop)
+                return settled(array)
+            },
+            run(array) {
+                deleteLength(array)
+                return array
+            },
+            metrics: reclaim
         })
+        bench.add(`create→modify→discard ${tag}`, {
+            setup: benchElements.defineElements,
+            run(_, eleNum) {
+                const array = []
+                create(array, eleNum, tagName)
+                modify(array, url, prop)
+                array.length = 0
+                return array
+            }
+        })
+        bench.add(`acquire→modify→release ${tag}`, {
+            setup(eleNum) {
+                benchElements.defineElements()
+                if (!pools.has(tagName)) pools.set(tagName, new elementPool.ElementPool(tagName, { size: eleNum }))
+                return pools.get(tagName)
+            },
+            run: (pool, eleNum) => cycle(pool, eleNum, url, prop)
+        })
+    }
+}
+
+// 有 src 的元素改 src，其余改 title。自定义元素见 dom/bench-elements.js
+const SRC_TAGS = new Set(['audio', 'video', 'img'])
+const TAGS = ['video', 'img', 'div', 'span', 'ce-plain', 'ce-heavy']
+
+function createModified(eleNum, url) {
+    const array = []
+    create(array, eleNum)
+    modify(array, url)
+    return array
+}
 
+function settled(value) {
+    return new Promise(resolve => setTimeout(() => resolve(value), 0))
 }
 
+function create(array, eleNum, tagName = 'audio') {
+    for (let i = 0; i < eleNum; i++) {
+        array.push(document.createElement(tagName))
+
+    }
+}
+
+function createByClone(array, eleNum) {
+    const proto = document.createElement('audio')
+    for (let i = 0; i < eleNum; i++) {
+        array.push(proto.cloneNode(false))
+    }
+}
 
+// template 里放一批元素，整批克隆 content
+const TEMPLATE_BATCH = 100
 
+function createByTemplate(array, eleNum) {
+    const template = document.createElement('template')
+    template.innerHTML = '<audio></audio>'.repeat(TEMPLATE_BATCH)
+    for (let left = eleNum; left > 0; left -= TEMPLATE_BATCH) {
+        const content = template.content.cloneNode(true)
+        let node = content.firstChild
+        for (let k = Math.min(left, TEMPLATE_BATCH); k > 0; k--) {
+            array.push(node)
+            node = node.nextSibling
+        }
+    }
+}
 
-function create(array, eleNum) {
+function createByFragment(array, eleNum) {
+    const fragment = document.createDocumentFragment()
     for (let i = 0; i < eleNum; i++) {
-        array.push(document.createElement('audio'))
+        fragment.appendChild(document.createElement('audio'))
+    }
+    for (let node = fragment.firstChild; node; node = node.nextSibling) {
+        array.push(node)
+    }
+}
 
+function createByHTML(array, eleNum) {
+    const container = document.createElement('div')
+    container.innerHTML = '<audio></audio>'.repeat(eleNum)
+    for (let node = container.firstChild; node; node = node.nextSibling) {
+        array.push(node)
     }
 }
 
-function modify(array, url) {
+function modify(array, url, prop = 'src') {
     for (const i of array) {
-        i.src = url
+        i[prop] = url
     }
 }
 
+function cycle(pool, eleNum, url, prop) {
+    const array = []
+    for (let i = 0; i < eleNum; i++) {
+        array.push(pool.acquire())
+    }
+    modify(array, url, prop)
+    for (const i of array) {
+        pool.release(i)
+    }
+    return array
+}
+
 function deleteGC(array) {
     while (array.length > 0) {
         array.shift()
@@ -56,4 +268,36 @@ function deleteNull(array) {
     for (let i = 0; i < array.length; i++) {
         array[i] = null
     }
-}
\ No newline at end of file
+}
+
+function deleteLength(array) {
+    array.length = 0
+}
+
+function deleteSplice(array) {
+    array.splice(0)
+}
+
+function deleteReassign(holder) {
+    holder.array = []
+}
+
+/**
+ * 强制GC一次，返回耗时和回收掉的字节
+ */
+function reclaim() {
+    if (typeof gc !== 'function') return { gcTime: NaN, freed: NaN }
+    const before = harness.heapUsed(),
+        start = harness.now()
+    gc()
+    return { gcTime: harness.now() - start, freed: before - harness.heapUsed() }
+}
+
+if (typeof module !== 'undefined') {
+    module.exports = {
+        needsDOM: true,
+        defaults: { n: 5000 },
+        startTest, prepare, register, create, createByClone, createByTemplate, createByFragment, createByHTML,
+        modify, deleteGC, deleteNull, deleteLength, deleteSplice, deleteReassign
+    }
+}
@@ -0,0 +1,222 @@
+const harness = typeof require === 'function' ? require('../harness/bench') : { Bench, report, toJSON, now }
+const htmlElement = typeof require === 'function' ? require('./htmlelement') : { prepare, create, modify }
+
+/**
+ * modify() 的几种写法：属性赋值还是 setAttribute，攒到微任务/下一帧再统一写，
+ * 元素挂在文档上还是没挂，以及记住上次的值、没变就跳过的 diff 写法。
+ * 除了 JS 时间，还记录 loads(触发的 loadstart 次数，即资源加载)、layout(写完后强制布局的耗时)。
+ * 批量模式下计时的只是同步入队的部分，flush 在计时之外等待，
+ * jsTime 是入队加上 flush 本身的耗时(不含等待微任务/帧的时间)，和直接写的用例比 JS 开销时看它。
+ *
+ * @author KotoriK
+ */
+function testModify(testUrl) {
+    const bench = new harness.Bench('dom/modify-batch', DEFAULTS)
+    return htmlElement.prepare({ url: testUrl }).then((context) => {
+        register(bench, context)
+        return bench.run()
+    }).then((results) => {
+        harness.report(results)
+        return harness.toJSON('dom/modify-batch', results)
+    })
+}
+
+const DEFAULTS = { n: 5000, samples: 20 }
+
+/**
+ * 把写操作攒起来，由 schedule 决定什么时候统一执行。同一个元素多次写入只保留最后一次
+ *
+ * @param {(flush: Function) => void} schedule 如 queueMicrotask、requestAnimationFrame
+ */
+function createBatcher(schedule) {
+    const pending = new Map()
+    let scheduled = null
+    const batcher = {
+        jsTime: 0,
+        set(el, value) {
+            pending.set(el, value)
+            if (!scheduled) {
+                scheduled = new Promise(resolve => schedule(() => {
+                    const start = harness.now()
+                    for (const [el, value] of pending) {
+                        el.src = value
+                    }
+                    pending.clear()
+                    batcher.jsTime = harness.now() - start
+                    scheduled = null
+                    resolve()
+                }))
+            }
+            return scheduled
+        }
+    }
+    return batcher
+}
+
+/**
+ * 记住每个元素上次写入的值，没变就不碰 DOM
+ */
+function createUpdater() {
+    const last = new WeakMap()
+    return function update(el, value) {
+        if (last.get(el) === value) return false
+        last.set(el, value)
+        el.src = value
+        return true
+    }
+}
+
+const settle = () => new Promise(resolve => setTimeout(resolve, 20))
+
+/**
+ * 建好元素并监听 loadstart 计数；attached 时挂到 document.body 下的容器里
+ */
+function setupElements(eleNum, attached) {
+    const array = [],
+        counter = { loads: 0 },
+        onLoad = () => counter.loads++
+    htmlElement.create(array, eleNum)
+    for (const el of array) {
+        el.addEventListener('loadstart', onLoad)
+    }
+    const container = document.createElement('div')
+    if (attached) {
+        for (const el of array) {
+            container.appendChild(el)
+        }
+        document.body.appendChild(container)
+    }
+    return { array, counter, container }
+}
+
+// 先强制布局并计时，再等加载事件派发完
+async function sideEffects(state, jsTime) {
+    const start = harness.now()
+    void state.container.offsetHeight
+    const layout = harness.now() - start
+    await settle()
+    const metrics = { loads: state.counter.loads / state.array.length, layout }
+    if (jsTime !== undefined) metrics.jsTime = jsTime
+    return metrics
+}
+
+function teardown(state) {
+    state.container.remove()
+}
+
+function register(bench, context) {
+    const url = context.url
+    const variants = [
+        ['property', false, (array) => htmlElement.modify(array, url)],
+        ['setAttribute', false, (array) => {
+            for (const el of array) {
+                el.setAttribute('src', url)
+            }
+        }],
+        ['attached property', true, (array) => htmlElement.modify(array, url)],
+        ['attached setAttribute', true, (array) => {
+            for (const el of array) {
+                el.setAttribute('src', url)
+            }
+        }],
+    ]
+    for (const [name, attached, write] of variants) {
+        bench.add(name, {
+            setup: eleNum => setupElements(eleNum, attached),
+            run(state) {
+                write(state.array)
+                return state
+            },
+            metrics: state => sideEffects(state),
+            teardown
+        })
+    }
+    //批量: 写入攒到微任务或下一帧；twice 表示每个元素先写一个中间值再写最终值，看合并的效果
+    const schedulers = {
+        'microtask batch': fn => queueMicrotask(fn),
+        'rAF batch': fn => requestAnimationFrame(fn),
+    }
+    for (const name in schedulers) {
+        for (const twice of [false, true]) {
+            bench.add(twice ? `${name} twice` : name, {
+                setup(eleNum) {
+                    const state = setupElements(eleNum, true)
+                    state.batcher = createBatcher(schedulers[name])
+                    return state
+                },
+                // 只计同步入队，不返回 flush 的 Promise，否则每次采样都包含等下一帧的时间
+                run(state) {
+                    const start = harness.now()
+                    for (const el of state.array) {
+                        if (twice) state.batcher.set(el, url + '#interim')
+                        state.flushed = state.batcher.set(el, url)
+                    }
+                    state.enqueueTime = harness.now() - start
+                    return state
+                },
+                async metrics(state) {
+                    await state.flushed
+                    return sideEffects(state, state.enqueueTime + state.batcher.jsTime)
+                },
+                teardown
+            })
+        }
+    }
+    bench.add('attached property twice', {
+        setup: eleNum => setupElements(eleNum, true),
+        run(state) {
+            for (const el of state.array) {
+                el.src = url + '#interim'
+                el.src = url
+            }
+            return state
+        },
+        metrics: state => sideEffects(state),
+        teardown
+    })
+    //一半元素的值已经是 url: 直接写 vs diff 跳过
+    bench.add('half unchanged property', {
+        async setup(eleNum) {
+            const state = setupElements(eleNum, true)
+            for (let i = 0; i < eleNum; i += 2) {
+                state.array[i].src = url
+            }
+            await settle()
+            state.counter.loads = 0
+            return state
+        },
+        run(state) {
+            htmlElement.modify(state.array, url)
+            return state
+        },
+        metrics: state => sideEffects(state),
+        teardown
+    })
+    bench.add('half unchanged diff', {
+        async setup(eleNum) {
+            const state = setupElements(eleNum, true)
+            state.update = createUpdater()
+            for (let i = 0; i < eleNum; i += 2) {
+                state.update(state.array[i], url)
+            }
+            await settle()
+            state.counter.loads = 0
+            return state
+        },
+        run(state) {
+            for (const el of state.array) {
+                state.update(el, url)
+            }
+            return state
+        },
+        metrics: state => sideEffects(state),
+        teardown
+    })
+}
+
+if (typeof module !== 'undefined') {
+    module.exports = {
+        needsDOM: true, defaults: DEFAULTS, prepare: htmlElement.prepare,
+        testModify, createBatcher, createUpdater, register
+    }
+}
@@ -0,0 +1,144 @@
+const harness = typeof require === 'function' ? require('../harness/bench') : { Bench, report, toJSON }
+const objectURLCache = typeof require === 'function' ? require('../lib/object-url-cache') : { ObjectURLCache }
+
+/**
+ * modify() 给所有元素用同一个 object URL，而且从来不 revoke，Blob 会一直留在内存里。
+ * 这里给每个元素一个不同的 Blob，走完 赋值→释放 的完整流程，比较：不 revoke、释放时 revoke、
+ * 以及多个元素共用 Blob 时用引用计数缓存(lib/object-url-cache.js)。
+ * 看 retained(走完流程后还占着的内存)和单次赋值的延迟。
+ * Node 下 Blob 的数据算在 arrayBuffers 里，harness 已经算进去了；浏览器的 performance.memory 看不到 Blob 存储。
+ *
+ * @author KotoriK
+ * @param {number} [eleNum]
+ */
+function testObjectURL(eleNum = 1000) {
+    const bench = new harness.Bench('dom/object-url', Object.assign({}, DEFAULTS, { n: eleNum }))
+    register(bench, {})
+    return bench.run().then((results) => {
+        harness.report(results)
+        return harness.toJSON('dom/object-url', results)
+    })
+}
+
+const DEFAULTS = { n: 1000, gc: true }
+// 每个 Blob 的大小，以及缓存模式下多少个元素共用一个 Blob
+const BLOB_SIZE = 1 << 16
+const SHARE = 10
+
+function makeBlobs(count, size) {
+    const chunk = new Uint8Array(size),
+        blobs = []
+    for (let i = 0; i < count; i++) {
+        blobs.push(new Blob([chunk]))
+    }
+    return blobs
+}
+
+function createElements(eleNum) {
+    const array = []
+    for (let i = 0; i < eleNum; i++) {
+        array.push(document.createElement('audio'))
+    }
+    return array
+}
+
+function register(bench, context) {
+    const size = context.blobSize ? +context.blobSize : BLOB_SIZE
+    //完整流程: 生成 Blob → 赋值 → 释放。run 里生成的 Blob 除了 URL 没有别的引用
+    bench.add('lifecycle no revoke', {
+        setup: createElements,
+        run(array) {
+            const blobs = makeBlobs(array.length, size),
+                urls = []
+            for (let i = 0; i < array.length; i++) {
+                urls.push(array[i].src = URL.createObjectURL(blobs[i]))
+            }
+            for (const el of array) {
+                el.removeAttribute('src')
+            }
+            return urls
+        },
+        // 量完再 revoke，免得泄漏的 Blob 影响后面的用例
+        teardown(_, urls) {
+            for (const u of urls) URL.revokeObjectURL(u)
+        }
+    })
+    bench.add('lifecycle revoke', {
+        setup: createElements,
+        run(array) {
+            const blobs = makeBlobs(array.length, size)
+            for (let i = 0; i < array.length; i++) {
+                array[i].src = URL.createObjectURL(blobs[i])
+            }
+            for (const el of array) {
+                URL.revokeObjectURL(el.src)
+                el.removeAttribute('src')
+            }
+            return array
+        }
+    })
+    bench.add('lifecycle cache', {
+        setup: createElements,
+        run(array) {
+            const blobs = makeBlobs(Math.ceil(array.length / SHARE), size),
+                cache = new objectURLCache.ObjectURLCache()
+            for (let i = 0; i < array.length; i++) {
+                array[i].src = cache.acquire(blobs[i % blobs.length])
+            }
+            for (const el of array) {
+                cache.release(el.src)
+                el.removeAttribute('src')
+            }
+            return cache
+        }
+    })
+    //只看赋值: Blob 事先建好，逐次计时得到赋值延迟
+    bench.add('assign distinct', {
+        setup: eleNum => ({ array: createElements(eleNum), blobs: makeBlobs(eleNum, size) }),
+        run({ array, blobs }) {
+            for (let i = 0; i < array.length; i++) {
+                array[i].src = URL.createObjectURL(blobs[i])
+            }
+            return array
+        },
+        op: ({ array, blobs }, i) => array[i].src = URL.createObjectURL(blobs[i]),
+        teardown({ array }) {
+            for (const el of array) {
+                if (el.src) URL.revokeObjectURL(el.src)
+            }
+        }
+    })
+    bench.add('assign cached', {
+        setup: eleNum => ({
+            array: createElements(eleNum),
+            blobs: makeBlobs(Math.ceil(eleNum / SHARE), size),
+            cache: new objectURLCache.ObjectURLCache()
+        }),
+        run({ array, blobs, cache }) {
+            for (let i = 0; i < array.length; i++) {
+                array[i].src = cache.acquire(blobs[i % blobs.length])
+            }
+            return array
+        },
+        op: ({ array, blobs, cache }, i) => array[i].src = cache.acquire(blobs[i % blobs.length]),
+        teardown: ({ cache }) => cache.clear()
+    })
+    bench.add('assign shared (modify)', {
+        setup(eleNum) {
+            const url = URL.createObjectURL(makeBlobs(1, size)[0])
+            return { array: createElements(eleNum), url }
+        },
+        run({ array, url }) {
+            for (const el of array) {
+                el.src = url
+            }
+            return array
+        },
+        op: ({ array, url }, i) => array[i].src = url,
+        teardown: ({ url }) => URL.revokeObjectURL(url)
+    })
+}
+
+if (typeof module !== 'undefined') {
+    module.exports = { needsDOM: true, defaults: DEFAULTS, testObjectURL, register }
+}
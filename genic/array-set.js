@@ -1,94 +1,472 @@
+const harness = typeof require === 'function' ? require('../harness/bench') : { Bench, report, toJSON }
+const ringQueue = typeof require === 'function' ? require('../lib/ring-queue') : { RingQueue }
+const chunkDeque = typeof require === 'function' ? require('../lib/chunk-deque') : { ChunkDeque }
+const orderedSet = typeof require === 'function' ? require('../lib/ordered-set') : { OrderedSet }
+const typedVector = typeof require === 'function' ? require('../lib/typed-vector') : { TypedVector }
+const intHashSet = typeof require === 'function' ? require('../lib/int-hash-set') : { IntHashSet }
+
 /**
  * 测试set和array的添加元素性能。结论就是没有必要不要用shift。看来array并不能当Queue的js版？
+ * 要队列的话用 lib/ring-queue.js 的 RingQueue，push/shift 都是 O(1)
+ * 要按优先级出队(push 之后 sort 再 shift)的话用 lib/binary-heap.js，对比见 genic/priority-queue.js
+ * 各规模下的曲线: node harness/sweep.js genic/array-set.js --csv sweep.csv
+ * 保存结果并和基线对比: node harness/run.js genic/array-set.js --json cur.json && node harness/compare.js base.json cur.json
+ * 每个用例单独进程、计时前强制GC: node harness/isolate.js genic/array-set.js --gc
  * 
  * @author KotoriK
  * @param {*} times
  */
 function test(times) {
-    var a = new Set(),
-        b = [],
-        c = [],
-        d = []
-    console.time('set add')
+    const bench = new harness.Bench('array-set', { n: times })
+    register(bench)
+    return bench.run().then(results => {
+        harness.report(results)
+        return harness.toJSON('genic/array-set', results)
+    })
+}
+
+function fillSet(times) {
+    const a = new Set()
     for (let i = 0; i < times; i++) {
         a.add(i)
     }
-    console.timeEnd('set add')
+    return a
+}
 
-    console.time('array push')
+function fillRing(times, ArrayType) {
+    const q = new ringQueue.RingQueue(16, ArrayType)
     for (let i = 0; i < times; i++) {
-        b.push(i)
+        q.push(i)
     }
-    console.timeEnd('array push')
+    return q
+}
 
-    console.time('array unshift')
+function fillDeque(times) {
+    const q = new chunkDeque.ChunkDeque()
     for (let i = 0; i < times; i++) {
-        c.unshift(i)
+        q.push(i)
     }
-    console.timeEnd('array unshift')
+    return q
+}
 
-    console.time('array [i]=i')
+function fillOrdered(times) {
+    const o = new orderedSet.OrderedSet()
     for (let i = 0; i < times; i++) {
-        d[i] = i
+        o.add(i)
     }
-    console.timeEnd('array [i]=i')
-    console.warn(a)
-    console.warn(b)
-    console.warn(c)
-    console.warn(d)
-    //get last
-    let last
-    console.time('set getLast')
+    return o
+}
+
+function fillVector(times) {
+    const v = new typedVector.TypedVector(Int32Array)
     for (let i = 0; i < times; i++) {
-       last= (()=>{
-           let count=0,target=a.size-1
-           for(const i of a.values()){
-               if(count==target)return i
-               count++
-           }
-        })()
-        
+        v.push(i)
     }
-    console.timeEnd('set getLast')
-    console.log(last)
-    //array
-    console.time('array getLast')
+    return v
+}
+
+function fillInts(h, times) {
     for (let i = 0; i < times; i++) {
-       last= (()=>{
-            
-        return b[b.length-1]
-        })()
-        
+        h.add(i)
     }
-    console.timeEnd('array getLast')
-    console.log(last)
-    //
-    setTimeout(() => {
-        console.time('set delete')
-        for (let i = 0; i < times; i++) {
-            a.delete(i)
-        }
-        console.timeEnd('set delete')
+    return h
+}
 
-        console.time('array pop')
-        for (let i = 0; i < times; i++) {
-            b.pop()
-        }
-        console.timeEnd('array pop')
+function fillIntSet(times) {
+    return fillInts(new intHashSet.IntHashSet(), times)
+}
 
-        console.time('array shift')
-        for (let i = 0; i < times; i++) {
-            c.shift()
-        }
-        console.timeEnd('array shift')
+function fillArray(times) {
+    const b = []
+    for (let i = 0; i < times; i++) {
+        b.push(i)
+    }
+    return b
+}
 
-        /* console.time('array [i]=i')
+/**
+ * 把用例注册到 Bench 上。需要预先填好的容器放在 setup 里，不计入时间
+ *
+ * @param {Bench} bench
+ */
+function register(bench) {
+    bench.add('set add', {
+        setup: () => new Set(),
+        run(a, times) {
+            for (let i = 0; i < times; i++) {
+                a.add(i)
+            }
+            return a
+        },
+        op: (a, i) => a.add(i)
+    })
+    bench.add('array push', {
+        setup: () => [],
+        run(b, times) {
+            for (let i = 0; i < times; i++) {
+                b.push(i)
+            }
+            return b
+        },
+        op: (b, i) => b.push(i)
+    })
+    bench.add('array unshift', {
+        setup: () => [],
+        run(c, times) {
+            for (let i = 0; i < times; i++) {
+                c.unshift(i)
+            }
+            return c
+        },
+        op: (c, i) => c.unshift(i)
+    })
+    bench.add('array [i]=i', {
+        setup: () => [],
+        run(d, times) {
+            for (let i = 0; i < times; i++) {
+                d[i] = i
+            }
+            return d
+        },
+        op: (d, i) => d[i] = i
+    })
+    //预分配: 已知大小时先分配再写。分配也算在时间里，和从 [] 开始 push/[i]=i 比；
+    //heapΔ 是这一轮的分配量，retained 是填满后的实际占用
+    const preallocs = {
+        'new Array(n)': times => new Array(times),
+        'Array.from({length})': times => Array.from({ length: times }),
+        'new Array(n).fill(0)': times => new Array(times).fill(0),
+        'Int32Array': times => new Int32Array(times),
+        'Float64Array': times => new Float64Array(times),
+    }
+    for (const name in preallocs) {
+        const alloc = preallocs[name]
+        bench.add(`prealloc ${name} [i]=i`, (times) => {
+            const a = alloc(times)
+            for (let i = 0; i < times; i++) {
+                a[i] = i
+            }
+            return a
+        })
+    }
+    bench.add('prealloc typedVector reserve+push (alloc timed)', (times) => {
+        const v = new typedVector.TypedVector(Int32Array)
+        v.reserve(times)
         for (let i = 0; i < times; i++) {
-            d[i] = i
+            v.push(i)
+        }
+        return v
+    })
+    //get last: 原生 Set 只能从头迭代到 size-1，OrderedSet 直接按下标取
+    bench.add('set getLast', {
+        setup: fillSet,
+        run(a, times) {
+            let last
+            for (let i = 0; i < times; i++) {
+                last = (() => {
+                    let count = 0, target = a.size - 1
+                    for (const i of a.values()) {
+                        if (count == target) return i
+                        count++
+                    }
+                })()
+            }
+            return last
         }
-        console.timeEnd('array [i]=i') */
+    })
+    bench.add('array getLast', {
+        setup: fillArray,
+        run(b, times) {
+            let last
+            for (let i = 0; i < times; i++) {
+                last = (() => {
+                    return b[b.length - 1]
+                })()
+            }
+            return last
+        }
+    })
+    bench.add('orderedSet getLast', {
+        setup: fillOrdered,
+        run(o, times) {
+            let last
+            for (let i = 0; i < times; i++) {
+                last = o.last()
+            }
+            return last
+        }
+    })
+    bench.add('orderedSet nth', {
+        setup: fillOrdered,
+        run(o, times) {
+            let x
+            for (let i = 0; i < times; i++) {
+                x = o.nth(i)
+            }
+            return x
+        }
+    })
+    //delete 和 nth 交替: 每次 nth 都要先压缩掉刚打的墓碑，整体 O(n²)，规模上限 2000；swapDelete 不留墓碑
+    const interleaved = { n: Math.min(bench.options.n, 2000) }
+    for (const del of ['delete', 'swapDelete']) {
+        bench.add(`orderedSet ${del}+nth`, {
+            setup: fillOrdered,
+            run(o, times) {
+                let x
+                for (let i = 0; i < times; i++) {
+                    o[del](i)
+                    x = o.nth(o.size >> 1)
+                    o.add(times + i)
+                }
+                return x
+            }
+        }, interleaved)
+    }
+    //delete
+    bench.add('set delete', {
+        setup: fillSet,
+        run(a, times) {
+            for (let i = 0; i < times; i++) {
+                a.delete(i)
+            }
+            return a
+        },
+        op: (a, i) => a.delete(i)
+    })
+    bench.add('orderedSet add', {
+        setup: () => new orderedSet.OrderedSet(),
+        run(o, times) {
+            for (let i = 0; i < times; i++) {
+                o.add(i)
+            }
+            return o
+        },
+        op: (o, i) => o.add(i)
+    })
+    bench.add('orderedSet delete', {
+        setup: fillOrdered,
+        run(o, times) {
+            for (let i = 0; i < times; i++) {
+                o.delete(i)
+            }
+            return o
+        },
+        op: (o, i) => o.delete(i)
+    })
+    bench.add('orderedSet swapDelete', {
+        setup: fillOrdered,
+        run(o, times) {
+            for (let i = 0; i < times; i++) {
+                o.swapDelete(i)
+            }
+            return o
+        },
+        op: (o, i) => o.swapDelete(i)
+    })
+    bench.add('array pop', {
+        setup: fillArray,
+        run(b, times) {
+            for (let i = 0; i < times; i++) {
+                b.pop()
+            }
+            return b
+        },
+        op: b => b.pop()
+    })
+    bench.add('array shift', {
+        setup: fillArray,
+        run(c, times) {
+            for (let i = 0; i < times; i++) {
+                c.shift()
+            }
+            return c
+        },
+        op: c => c.shift()
+    })
+    //queue: 环形缓冲区对比 unshift/shift
+    for (const ArrayType of [Array, Int32Array]) {
+        const tag = ArrayType === Array ? 'ring' : `ring(${ArrayType.name})`
+        bench.add(`${tag} push`, {
+            setup: () => new ringQueue.RingQueue(16, ArrayType),
+            run(q, times) {
+                for (let i = 0; i < times; i++) {
+                    q.push(i)
+                }
+                return q
+            },
+            op: (q, i) => q.push(i)
+        })
+        bench.add(`${tag} shift`, {
+            setup: times => fillRing(times, ArrayType),
+            run(q, times) {
+                for (let i = 0; i < times; i++) {
+                    q.shift()
+                }
+                return q
+            },
+            op: q => q.shift()
+        })
+    }
+    //deque: 分块双端队列，两端各测一遍，看吞吐量和单次最坏延迟
+    bench.add('deque push', {
+        setup: () => new chunkDeque.ChunkDeque(),
+        run(q, times) {
+            for (let i = 0; i < times; i++) {
+                q.push(i)
+            }
+            return q
+        },
+        op: (q, i) => q.push(i)
+    })
+    bench.add('deque unshift', {
+        setup: () => new chunkDeque.ChunkDeque(),
+        run(q, times) {
+            for (let i = 0; i < times; i++) {
+                q.unshift(i)
+            }
+            return q
+        },
+        op: (q, i) => q.unshift(i)
+    })
+    bench.add('deque shift', {
+        setup: fillDeque,
+        run(q, times) {
+            for (let i = 0; i < times; i++) {
+                q.shift()
+            }
+            return q
+        },
+        op: q => q.shift()
+    })
+    bench.add('deque pop', {
+        setup: fillDeque,
+        run(q, times) {
+            for (let i = 0; i < times; i++) {
+                q.pop()
+            }
+            return q
+        },
+        op: q => q.pop()
+    })
+    //typed: Int32Array 存储的向量和整数哈希集合，对比 [] 和 new Set()
+    bench.add('typedVector push', {
+        setup: () => new typedVector.TypedVector(Int32Array),
+        run(v, times) {
+            for (let i = 0; i < times; i++) {
+                v.push(i)
+            }
+            return v
+        },
+        op: (v, i) => v.push(i)
+    })
+    bench.add('typedVector [i]=i', {
+        setup: () => new typedVector.TypedVector(Int32Array),
+        run(v, times) {
+            for (let i = 0; i < times; i++) {
+                v.set(i, i)
+            }
+            return v
+        },
+        op: (v, i) => v.set(i, i)
+    })
+    bench.add('typedVector getLast', {
+        setup: fillVector,
+        run(v, times) {
+            let last
+            for (let i = 0; i < times; i++) {
+                last = v.last()
+            }
+            return last
+        }
+    })
+    bench.add('typedVector pop', {
+        setup: fillVector,
+        run(v, times) {
+            for (let i = 0; i < times; i++) {
+                v.pop()
+            }
+            return v
+        },
+        op: v => v.pop()
+    })
+    bench.add('intHashSet add', {
+        setup: () => new intHashSet.IntHashSet(),
+        run(h, times) {
+            for (let i = 0; i < times; i++) {
+                h.add(i)
+            }
+            return h
+        },
+        op: (h, i) => h.add(i)
+    })
+    bench.add('intHashSet delete', {
+        setup: fillIntSet,
+        run(h, times) {
+            for (let i = 0; i < times; i++) {
+                h.delete(i)
+            }
+            return h
+        },
+        op: (h, i) => h.delete(i)
+    })
+    bench.add('robinHood add', {
+        setup: () => new intHashSet.RobinHoodIntSet(),
+        run(h, times) {
+            for (let i = 0; i < times; i++) {
+                h.add(i)
+            }
+            return h
+        },
+        op: (h, i) => h.add(i)
+    })
+    bench.add('robinHood delete', {
+        setup: times => fillInts(new intHashSet.RobinHoodIntSet(), times),
+        run(h, times) {
+            for (let i = 0; i < times; i++) {
+                h.delete(i)
+            }
+            return h
+        },
+        op: (h, i) => h.delete(i)
+    })
+    //查找为主(一半命中)和插入删除交替(窗口往前滑)，三种集合同样的负载
+    const sets = {
+        set: () => new Set(),
+        intHashSet: () => new intHashSet.IntHashSet(),
+        robinHood: () => new intHashSet.RobinHoodIntSet(),
+    }
+    for (const tag in sets) {
+        bench.add(`${tag} has 50% hit`, {
+            setup: times => fillInts(sets[tag](), times),
+            run(h, times) {
+                let found = 0
+                for (let i = 0; i < times; i++) {
+                    if (h.has(i << 1)) found++
+                }
+                return found
+            },
+            op: (h, i) => h.has(i << 1)
+        })
+        bench.add(`${tag} mixed add/delete`, {
+            setup: times => fillInts(sets[tag](), times),
+            run(h, times) {
+                for (let i = 0; i < times; i++) {
+                    h.add(i + times)
+                    h.delete(i)
+                }
+                return h
+            },
+            op(h, i) {
+                h.add(i + h.size)
+                h.delete(i)
+            }
+        })
+    }
+}
 
-    }, 200)
+if (typeof module !== 'undefined') {
+    module.exports = { test, register }
+    if (require.main === module) test(+process.argv[2] || 100000)
 }
 /* test(100000)
 VM228:10 set add: 9.45703125ms
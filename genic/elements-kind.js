@@ -0,0 +1,167 @@
+const harness = typeof require === 'function' ? require('../harness/bench') : { Bench, report, toJSON }
+
+/**
+ * array-set.js 里的 push 和 d[i] = i 只碰到了 V8 最快的 PACKED_SMI。
+ * 这里在 packed SMI、packed double、holey、字典模式(稀疏)、混合类型(PACKED_ELEMENTS)的数组上
+ * 各测 push/[i]=v/pop/shift，再单独测一次转换本身：往 n 个元素的数组里写一个"不合适"的值，
+ * 整个 backing store 要重新分配、逐个转换，perOp 就是每个元素摊到的转换开销。
+ * 注意 V8 的转换只会往更通用的方向走(SMI → double → object，packed → holey)，退不回来，
+ * 只有字典模式在变得足够稠密时会被转回快速模式(比如 push 了很多之后)。
+ *
+ * 用 --allow-natives-syntax 跑时可以用 %HasDictionaryElements 等确认每种数组的实际类型
+ *
+ * @author KotoriK
+ * @param {number} times
+ */
+function test(times) {
+    const bench = new harness.Bench('elements-kind', Object.assign({}, DEFAULTS, times && { n: times }))
+    register(bench)
+    return bench.run().then(results => {
+        harness.report(results)
+        return harness.toJSON('genic/elements-kind', results)
+    })
+}
+
+const DEFAULTS = { n: 10000 }
+
+// 超过 V8 的 kMaxGap(1024)的下标写入会让数组退化成字典模式
+const SPARSE_GAP = 2048
+
+const MARKER = { marker: true }
+
+function fillSmi(times) {
+    const a = []
+    for (let i = 0; i < times; i++) {
+        a.push(i)
+    }
+    return a
+}
+
+function fillDouble(times) {
+    const a = []
+    for (let i = 0; i < times; i++) {
+        a.push(i + 0.5)
+    }
+    return a
+}
+
+// new Array(n) 一开始就是 HOLEY，写满了也不会变回 PACKED
+function fillHoley(times) {
+    const a = new Array(times)
+    for (let i = 0; i < times; i++) {
+        a[i] = i
+    }
+    return a
+}
+
+function fillHoleyDouble(times) {
+    const a = new Array(times)
+    for (let i = 0; i < times; i++) {
+        a[i] = i + 0.5
+    }
+    return a
+}
+
+// 先在远处写一个下标变成字典模式，再把长度截回来，截断后仍是字典模式
+function fillSparse(times) {
+    const a = fillSmi(times)
+    a[times + SPARSE_GAP] = 0
+    a.length = times
+    return a
+}
+
+function fillMixed(times) {
+    const a = []
+    for (let i = 0; i < times; i++) {
+        a.push(i & 1 ? i : MARKER)
+    }
+    return a
+}
+
+/**
+ * 每种数组：怎么建、往里写什么值(保持原来的类型)
+ */
+const KINDS = {
+    'packed SMI': { fill: fillSmi, value: i => i },
+    'packed double': { fill: fillDouble, value: i => i + 0.5 },
+    'holey SMI': { fill: fillHoley, value: i => i },
+    'holey double': { fill: fillHoleyDouble, value: i => i + 0.5 },
+    'dictionary': { fill: fillSparse, value: i => i },
+    'mixed': { fill: fillMixed, value: i => i & 1 ? i : MARKER },
+}
+
+/**
+ * 把用例注册到 Bench 上。数组都在 setup 里建好，不计入时间
+ *
+ * @param {Bench} bench
+ */
+function register(bench) {
+    for (const kind in KINDS) {
+        const { fill, value } = KINDS[kind],
+            // 字典模式下 pop/shift 每次都是 O(n)，规模缩到 1/10，对比时看 perOp
+            slow = kind == 'dictionary' ? { n: Math.ceil(bench.options.n / 10) } : undefined
+        bench.add(`${kind} push`, {
+            setup: fill,
+            run(a, times) {
+                for (let i = 0; i < times; i++) {
+                    a.push(value(i))
+                }
+                return a
+            },
+            op: (a, i) => a.push(value(i))
+        })
+        bench.add(`${kind} [i]=v`, {
+            setup: fill,
+            run(a, times) {
+                for (let i = 0; i < times; i++) {
+                    a[i] = value(i)
+                }
+                return a
+            },
+            op: (a, i) => a[i] = value(i)
+        })
+        bench.add(`${kind} pop`, {
+            setup: fill,
+            run(a, times) {
+                for (let i = 0; i < times; i++) {
+                    a.pop()
+                }
+                return a
+            },
+            op: a => a.pop()
+        }, slow)
+        bench.add(`${kind} shift`, {
+            setup: fill,
+            run(a, times) {
+                for (let i = 0; i < times; i++) {
+                    a.shift()
+                }
+                return a
+            },
+            op: a => a.shift()
+        }, slow)
+    }
+    //转换本身: 一次写入触发整个数组的类型转换，耗时随 n 线性增长
+    const transitions = {
+        'SMI→double': [fillSmi, a => a[0] = 0.5],
+        'SMI→object': [fillSmi, a => a[0] = MARKER],
+        'double→object': [fillDouble, a => a[0] = MARKER],
+        'packed→holey': [fillSmi, a => a[a.length + 1] = 0],
+        'fast→dictionary': [fillSmi, a => a[a.length + SPARSE_GAP] = 0],
+    }
+    for (const name in transitions) {
+        const [fill, write] = transitions[name]
+        bench.add(`transition ${name}`, {
+            setup: fill,
+            run(a) {
+                write(a)
+                return a
+            }
+        })
+    }
+}
+
+if (typeof module !== 'undefined') {
+    module.exports = { defaults: DEFAULTS, test, register, KINDS }
+    if (require.main === module) test(+process.argv[2])
+}
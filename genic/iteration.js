@@ -0,0 +1,218 @@
+const harness = typeof require === 'function' ? require('../harness/bench') : { Bench, report, toJSON }
+
+/**
+ * array-set.js 的 set getLast 说明反复 for…of 一个 Set 很慢，这里单独测遍历本身：
+ * Set、Map、数组上的 for…of、forEach、下标 for、先展开成数组、Array.from、
+ * 以及缓存的快照数组(容器不变时只建一次，之后每帧直接按下标扫)。
+ * 每个用例把整个容器扫一遍，操作数就是元素个数。
+ * 再加上提前退出的查找：目标在前 1% 或正中间，能 break 的写法扫到就停，forEach 和先展开的写法总要走完全程。
+ *
+ * @author KotoriK
+ * @param {number} times
+ */
+function test(times) {
+    const bench = new harness.Bench('iteration', Object.assign({}, DEFAULTS, times && { n: times }))
+    register(bench)
+    return bench.run().then(results => {
+        harness.report(results)
+        return harness.toJSON('genic/iteration', results)
+    })
+}
+
+const DEFAULTS = { n: 100000, samples: 20 }
+
+// 查找目标所在的位置(占容器大小的比例)
+const POSITIONS = [0.01, 0.5]
+
+function fillArray(times) {
+    const a = []
+    for (let i = 0; i < times; i++) {
+        a.push(i)
+    }
+    return a
+}
+
+const fillSet = times => new Set(fillArray(times))
+
+const fillMap = times => new Map(fillArray(times).map(i => [i, i]))
+
+function sum(a) {
+    let total = 0
+    for (let i = 0; i < a.length; i++) {
+        total += a[i]
+    }
+    return total
+}
+
+/**
+ * 各写法完整扫一遍。snapshot 是 setup 里建好的快照数组
+ */
+const SCANS = {
+    Set: {
+        'for…of'(s) {
+            let total = 0
+            for (const v of s) total += v
+            return total
+        },
+        'for…of values()'(s) {
+            let total = 0
+            for (const v of s.values()) total += v
+            return total
+        },
+        'forEach'(s) {
+            let total = 0
+            s.forEach(v => total += v)
+            return total
+        },
+        'spread': s => sum([...s]),
+        'Array.from': s => sum(Array.from(s)),
+        'cached snapshot': (s, snapshot) => sum(snapshot),
+    },
+    Map: {
+        'for…of'(m) {
+            let total = 0
+            for (const [, v] of m) total += v
+            return total
+        },
+        'for…of values()'(m) {
+            let total = 0
+            for (const v of m.values()) total += v
+            return total
+        },
+        'forEach'(m) {
+            let total = 0
+            m.forEach(v => total += v)
+            return total
+        },
+        'spread': m => sum([...m.values()]),
+        'Array.from': m => sum(Array.from(m.values())),
+        'cached snapshot': (m, snapshot) => sum(snapshot),
+    },
+    array: {
+        'for…of'(a) {
+            let total = 0
+            for (const v of a) total += v
+            return total
+        },
+        'forEach'(a) {
+            let total = 0
+            a.forEach(v => total += v)
+            return total
+        },
+        'indexed for': a => sum(a),
+        'reduce': a => a.reduce((total, v) => total + v, 0),
+    },
+}
+
+/**
+ * 查找 target，返回是否找到
+ */
+const SEARCHES = {
+    Set: {
+        'for…of break'(s, snapshot, target) {
+            for (const v of s) {
+                if (v === target) return true
+            }
+            return false
+        },
+        'forEach'(s, snapshot, target) {
+            let found = false
+            s.forEach(v => {
+                if (v === target) found = true
+            })
+            return found
+        },
+        'spread indexOf': (s, snapshot, target) => [...s].indexOf(target) != -1,
+        'snapshot indexOf': (s, snapshot, target) => snapshot.indexOf(target) != -1,
+    },
+    Map: {
+        'for…of break'(m, snapshot, target) {
+            for (const v of m.values()) {
+                if (v === target) return true
+            }
+            return false
+        },
+        'forEach'(m, snapshot, target) {
+            let found = false
+            m.forEach(v => {
+                if (v === target) found = true
+            })
+            return found
+        },
+        'spread indexOf': (m, snapshot, target) => [...m.values()].indexOf(target) != -1,
+        'snapshot indexOf': (m, snapshot, target) => snapshot.indexOf(target) != -1,
+    },
+    array: {
+        'for…of break'(a, snapshot, target) {
+            for (const v of a) {
+                if (v === target) return true
+            }
+            return false
+        },
+        'indexed break'(a, snapshot, target) {
+            for (let i = 0; i < a.length; i++) {
+                if (a[i] === target) return true
+            }
+            return false
+        },
+        'forEach'(a, snapshot, target) {
+            let found = false
+            a.forEach(v => {
+                if (v === target) found = true
+            })
+            return found
+        },
+        'indexOf': (a, snapshot, target) => a.indexOf(target) != -1,
+        'includes': (a, snapshot, target) => a.includes(target),
+        'some': (a, snapshot, target) => a.some(v => v === target),
+        'find': (a, snapshot, target) => a.find(v => v === target) !== undefined,
+    },
+}
+
+const FILLS = { Set: fillSet, Map: fillMap, array: fillArray }
+
+function snapshotOf(container) {
+    return Array.isArray(container) ? container : Array.from(container.values())
+}
+
+/**
+ * 把用例注册到 Bench 上。容器和快照在第一次 setup 时建好，之后各次采样共用(遍历不修改容器)
+ *
+ * @param {Bench} bench
+ */
+function register(bench) {
+    const built = new Map()
+    function get(type, times) {
+        if (!built.has(type)) {
+            const container = FILLS[type](times)
+            built.set(type, { container, snapshot: snapshotOf(container) })
+        }
+        return built.get(type)
+    }
+    for (const type in SCANS) {
+        const scans = SCANS[type]
+        for (const name in scans) {
+            bench.add(`${type} ${name}`, {
+                setup: times => get(type, times),
+                run: state => scans[name](state.container, state.snapshot)
+            })
+        }
+    }
+    //提前退出: 操作数仍按整个容器算，perOp 越小说明扫得越少
+    for (const type in SEARCHES) {
+        const searches = SEARCHES[type]
+        for (const position of POSITIONS) {
+            for (const name in searches) {
+                bench.add(`${type} find@${position * 100}% ${name}`, {
+                    setup: times => get(type, times),
+                    run: (state, times) => searches[name](state.container, state.snapshot, Math.floor(times * position))
+                })
+            }
+        }
+    }
+}
+
+if (typeof module !== 'undefined') {
+    module.exports = { defaults: DEFAULTS, test, register }
+    if (require.main === module) test(+process.argv[2])
+}
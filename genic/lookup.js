@@ -0,0 +1,289 @@
+const harness = typeof require === 'function' ? require('../harness/bench') : { Bench, report, toJSON, PROBES, randomSequence }
+
+/**
+ * array-set.js 只测了插入删除，这里测查找：Set、Map、普通对象、Object.create(null)、稠密数组，
+ * 键分整数和字符串('k' + i，不会被当成数组下标)，各自在几种规模、几种命中率下的 has/get，
+ * 以及遍历一遍和全部删除的开销。数组只测整数键。
+ * 命中的键落在 [0, size)，不命中的落在 [size, 2size)，查询顺序是固定种子的伪随机。
+ *
+ * 用法: node harness/run.js genic/lookup.js [--sizes 100,10000,1000000] [--only "Map<int> get 100"]
+ * 同一个函数先后碰到整数键和字符串键会变成多态，要排除这种干扰就每个用例单独进程: node harness/isolate.js genic/lookup.js
+ *
+ * @author KotoriK
+ * @param {number} times
+ * @param {number[]} [sizes]
+ */
+function test(times, sizes) {
+    const bench = new harness.Bench('lookup', Object.assign({}, DEFAULTS, times && { n: times }))
+    return prepare({ sizes: sizes && sizes.join(',') }).then((context) => {
+        register(bench, context)
+        return bench.run()
+    }).then(results => {
+        harness.report(results)
+        return harness.toJSON('genic/lookup', results)
+    })
+}
+
+const DEFAULTS = { n: 100000, samples: 20 }
+const SIZES = [100, 10000, 100000]
+const HIT_RATIOS = [1, 0.5, 0]
+
+const PROBES = harness.PROBES
+
+function prepare(args) {
+    const sizes = args.sizes ? String(args.sizes).split(',').map(Number) : SIZES
+    return Promise.resolve({ sizes })
+}
+
+const intKey = i => i
+const stringKey = i => 'k' + i
+
+function makeKeys(key, size) {
+    const keys = new Array(size)
+    for (let i = 0; i < size; i++) {
+        keys[i] = key(i)
+    }
+    return keys
+}
+
+/**
+ * 查询序列：高16位决定命中与否，整个值对 size 取模决定查哪个键
+ */
+function makeProbes(key, size, hitRatio) {
+    const probes = new Array(PROBES),
+        random = harness.randomSequence(PROBES)
+    for (let i = 0; i < PROBES; i++) {
+        const seed = random[i],
+            k = seed % size
+        probes[i] = key((seed >>> 16) / 0x10000 < hitRatio ? k : k + size)
+    }
+    return probes
+}
+
+/**
+ * 每种容器: 怎么建、has/get/遍历/删除。每个操作单独写循环，不经过通用的适配函数，免得调用点变成多态
+ */
+const CONTAINERS = {
+    'Set': {
+        fill(keys) {
+            const s = new Set()
+            for (const k of keys) s.add(k)
+            return s
+        },
+        has(s, probes, times) {
+            let found = 0
+            for (let i = 0; i < times; i++) {
+                if (s.has(probes[i & (PROBES - 1)])) found++
+            }
+            return found
+        },
+        iterate(s) {
+            let count = 0
+            for (const k of s) {
+                if (k !== undefined) count++
+            }
+            return count
+        },
+        remove(s, keys) {
+            for (const k of keys) s.delete(k)
+            return s
+        },
+    },
+    'Map': {
+        fill(keys) {
+            const m = new Map()
+            for (const k of keys) m.set(k, k)
+            return m
+        },
+        has(m, probes, times) {
+            let found = 0
+            for (let i = 0; i < times; i++) {
+                if (m.has(probes[i & (PROBES - 1)])) found++
+            }
+            return found
+        },
+        get(m, probes, times) {
+            let found = 0
+            for (let i = 0; i < times; i++) {
+                if (m.get(probes[i & (PROBES - 1)]) !== undefined) found++
+            }
+            return found
+        },
+        iterate(m) {
+            let count = 0
+            for (const [, v] of m) {
+                if (v !== undefined) count++
+            }
+            return count
+        },
+        remove(m, keys) {
+            for (const k of keys) m.delete(k)
+            return m
+        },
+    },
+    'object': {
+        fill(keys) {
+            const o = {}
+            for (const k of keys) o[k] = k
+            return o
+        },
+        // 普通对象要用 in 才能排除原型链上的同名属性，这里的键不会和 Object.prototype 冲突
+        has(o, probes, times) {
+            let found = 0
+            for (let i = 0; i < times; i++) {
+                if (probes[i & (PROBES - 1)] in o) found++
+            }
+            return found
+        },
+        get(o, probes, times) {
+            let found = 0
+            for (let i = 0; i < times; i++) {
+                if (o[probes[i & (PROBES - 1)]] !== undefined) found++
+            }
+            return found
+        },
+        iterate(o) {
+            let count = 0
+            for (const k in o) {
+                if (o[k] !== undefined) count++
+            }
+            return count
+        },
+        remove(o, keys) {
+            for (const k of keys) delete o[k]
+            return o
+        },
+    },
+    'Object.create(null)': {
+        fill(keys) {
+            const o = Object.create(null)
+            for (const k of keys) o[k] = k
+            return o
+        },
+        has(o, probes, times) {
+            let found = 0
+            for (let i = 0; i < times; i++) {
+                if (probes[i & (PROBES - 1)] in o) found++
+            }
+            return found
+        },
+        get(o, probes, times) {
+            let found = 0
+            for (let i = 0; i < times; i++) {
+                if (o[probes[i & (PROBES - 1)]] !== undefined) found++
+            }
+            return found
+        },
+        iterate(o) {
+            let count = 0
+            for (const k in o) {
+                if (o[k] !== undefined) count++
+            }
+            return count
+        },
+        remove(o, keys) {
+            for (const k of keys) delete o[k]
+            return o
+        },
+    },
+    // 下标越界(不命中)也是 undefined；删除用写 undefined 代替 delete，避免变成 holey
+    'array': {
+        intOnly: true,
+        fill(keys) {
+            const a = []
+            for (const k of keys) a.push(k)
+            return a
+        },
+        has(a, probes, times) {
+            let found = 0
+            for (let i = 0; i < times; i++) {
+                if (a[probes[i & (PROBES - 1)]] !== undefined) found++
+            }
+            return found
+        },
+        get(a, probes, times) {
+            let sum = 0
+            for (let i = 0; i < times; i++) {
+                const v = a[probes[i & (PROBES - 1)]]
+                if (v !== undefined) sum += v
+            }
+            return sum
+        },
+        iterate(a) {
+            let count = 0
+            for (let i = 0; i < a.length; i++) {
+                if (a[i] !== undefined) count++
+            }
+            return count
+        },
+        remove(a, keys) {
+            for (const k of keys) a[k] = undefined
+            return a
+        },
+    },
+}
+
+const KEY_TYPES = { int: intKey, string: stringKey }
+
+/**
+ * 把用例注册到 Bench 上。只读的用例(has/get/遍历)共用同一个建好的容器，删除每次采样重建
+ *
+ * @param {Bench} bench
+ * @param {{sizes: number[]}} [context]
+ */
+function register(bench, context = {}) {
+    const sizes = context.sizes || SIZES
+    const built = new Map()
+    function get(name, keyType, size) {
+        const id = `${name}<${keyType}> ${size}`
+        if (!built.has(id)) built.set(id, CONTAINERS[name].fill(makeKeys(KEY_TYPES[keyType], size)))
+        return built.get(id)
+    }
+    for (const name in CONTAINERS) {
+        const c = CONTAINERS[name]
+        for (const keyType in KEY_TYPES) {
+            if (c.intOnly && keyType != 'int') continue
+            const key = KEY_TYPES[keyType]
+            for (const size of sizes) {
+                const tag = `${name}<${keyType}>`
+                for (const ratio of HIT_RATIOS) {
+                    let probes
+                    bench.add(`${tag} has ${size} ${ratio * 100}% hit`, {
+                        setup() {
+                            probes = probes || makeProbes(key, size, ratio)
+                            return get(name, keyType, size)
+                        },
+                        run: (container, times) => c.has(container, probes, times)
+                    })
+                }
+                if (c.get) {
+                    let probes
+                    bench.add(`${tag} get ${size}`, {
+                        setup() {
+                            probes = probes || makeProbes(key, size, 0.5)
+                            return get(name, keyType, size)
+                        },
+                        run: (container, times) => c.get(container, probes, times)
+                    })
+                }
+                //遍历和删除的操作数就是容器大小，perOp 是每个元素的开销
+                bench.add(`${tag} iterate ${size}`, {
+                    setup: () => get(name, keyType, size),
+                    run: container => c.iterate(container)
+                }, { n: size })
+                bench.add(`${tag} delete ${size}`, {
+                    setup() {
+                        const keys = makeKeys(key, size)
+                        return { keys, container: c.fill(keys) }
+                    },
+                    run: state => c.remove(state.container, state.keys)
+                }, { n: size })
+            }
+        }
+    }
+}
+
+if (typeof module !== 'undefined') {
+    module.exports = { defaults: DEFAULTS, test, prepare, register, makeProbes }
+    if (require.main === module) test(+process.argv[2])
+}
@@ -0,0 +1,169 @@
+const harness = typeof require === 'function' ? require('../harness/bench') : { Bench, report, toJSON, PROBES, randomSequence }
+const binaryHeap = typeof require === 'function' ? require('../lib/binary-heap') : { BinaryHeap, QuadHeap }
+
+/**
+ * 调度器里常见的"push 之后 sort 再 shift"对比 lib/binary-heap.js 的 BinaryHeap 和 QuadHeap(4叉、类型化数组)。
+ * 队列里常驻 size 个任务，每次操作出队一个再把它换个优先级重新入队(队列大小不变)，
+ * 另外测 decreaseKey：随机挑一个任务把优先级调高，数组只能改完再整体 sort。
+ * 数组的写法每次操作都是 O(size)，操作数按 size 缩小，对比时看 perOp。
+ *
+ * 用法: node harness/run.js genic/priority-queue.js [--sizes 1000,10000,100000,1000000]
+ *
+ * @author KotoriK
+ * @param {number} times
+ * @param {number[]} [sizes]
+ */
+function test(times, sizes) {
+    const bench = new harness.Bench('priority-queue', Object.assign({}, DEFAULTS, times && { n: times }))
+    return prepare({ sizes: sizes && sizes.join(',') }).then((context) => {
+        register(bench, context)
+        return bench.run()
+    }).then(results => {
+        harness.report(results)
+        return harness.toJSON('genic/priority-queue', results)
+    })
+}
+
+const DEFAULTS = { n: 10000, samples: 20 }
+const SIZES = [1e3, 1e4, 1e5, 1e6]
+
+// sort+shift 每次采样大约处理这么多个元素(操作数 × size)
+const SORT_BUDGET = 2e6
+
+const PROBES = harness.PROBES
+
+function prepare(args) {
+    const sizes = args.sizes ? String(args.sizes).split(',').map(Number) : SIZES
+    return Promise.resolve({ sizes })
+}
+
+const byPriority = (a, b) => a.priority - b.priority
+
+/**
+ * 随机优先级落在 [0, 1)，随机任务是 [0, size) 里的 id
+ */
+function makeRandom(size) {
+    const priorities = new Float64Array(PROBES),
+        ids = new Int32Array(PROBES),
+        random = harness.randomSequence(PROBES)
+    for (let i = 0; i < PROBES; i++) {
+        const seed = random[i]
+        priorities[i] = seed / 0x100000000
+        ids[i] = seed % size
+    }
+    return { priorities, ids }
+}
+
+function makeTasks(size, random) {
+    const tasks = new Array(size)
+    for (let id = 0; id < size; id++) {
+        tasks[id] = { id, priority: random.priorities[id & (PROBES - 1)] }
+    }
+    return tasks
+}
+
+/**
+ * 每种实现: 怎么建、出队再入队、decreaseKey。tasks[id] 是 id 对应的任务对象(QuadHeap 不用)
+ */
+const QUEUES = {
+    'sort+shift': {
+        fill(tasks) {
+            return tasks.slice().sort(byPriority)
+        },
+        cycle(a, random, times) {
+            for (let i = 0; i < times; i++) {
+                const task = a.shift()
+                task.priority = random.priorities[i & (PROBES - 1)]
+                a.push(task)
+                a.sort(byPriority)
+            }
+            return a
+        },
+        decreaseKey(a, random, times, tasks) {
+            for (let i = 0; i < times; i++) {
+                tasks[random.ids[i & (PROBES - 1)]].priority -= 0.5
+                a.sort(byPriority)
+            }
+            return a
+        },
+    },
+    'BinaryHeap': {
+        fill(tasks) {
+            const heap = new binaryHeap.BinaryHeap(byPriority)
+            for (const task of tasks) heap.push(task)
+            return heap
+        },
+        cycle(heap, random, times) {
+            for (let i = 0; i < times; i++) {
+                const task = heap.pop()
+                task.priority = random.priorities[i & (PROBES - 1)]
+                heap.push(task)
+            }
+            return heap
+        },
+        decreaseKey(heap, random, times, tasks) {
+            for (let i = 0; i < times; i++) {
+                const task = tasks[random.ids[i & (PROBES - 1)]]
+                task.priority -= 0.5
+                heap.decreaseKey(task)
+            }
+            return heap
+        },
+    },
+    'QuadHeap': {
+        fill(tasks) {
+            const heap = new binaryHeap.QuadHeap(tasks.length)
+            for (const task of tasks) heap.push(task.id, task.priority)
+            return heap
+        },
+        cycle(heap, random, times) {
+            for (let i = 0; i < times; i++) {
+                heap.push(heap.pop(), random.priorities[i & (PROBES - 1)])
+            }
+            return heap
+        },
+        decreaseKey(heap, random, times) {
+            for (let i = 0; i < times; i++) {
+                const id = random.ids[i & (PROBES - 1)]
+                heap.decreaseKey(id, heap.priorityOf(id) - 0.5)
+            }
+            return heap
+        },
+    },
+}
+
+/**
+ * 把用例注册到 Bench 上。每次采样前都用同样的初始优先级重新建队列(不计入时间)，
+ * 用例之间、采样之间互不影响，decreaseKey 调低的优先级不会累积
+ *
+ * @param {Bench} bench
+ * @param {{sizes: number[]}} [context]
+ */
+function register(bench, context = {}) {
+    for (const size of context.sizes || SIZES) {
+        const random = makeRandom(size)
+        for (const name in QUEUES) {
+            const q = QUEUES[name]
+            const setup = () => {
+                const tasks = makeTasks(size, random)
+                return { tasks, queue: q.fill(tasks) }
+            }
+            const options = name == 'sort+shift'
+                ? { n: Math.max(10, Math.min(bench.options.n, Math.floor(SORT_BUDGET / size))) }
+                : undefined
+            bench.add(`${name} pop+push ${size}`, {
+                setup,
+                run: (s, times) => q.cycle(s.queue, random, times)
+            }, options)
+            bench.add(`${name} decreaseKey ${size}`, {
+                setup,
+                run: (s, times) => q.decreaseKey(s.queue, random, times, s.tasks)
+            }, options)
+        }
+    }
+}
+
+if (typeof module !== 'undefined') {
+    module.exports = { defaults: DEFAULTS, test, prepare, register }
+    if (require.main === module) test(+process.argv[2])
+}
@@ -0,0 +1,394 @@
+/**
+ * 通用计时框架。每个用例先预热若干次，再采样多次，报告中位数、p95、标准差和均值的95%置信区间，
+ * 代替单次 console.time 的结果。
+ * Node 中用 require 引入；浏览器中先把本文件粘贴进控制台，再粘贴用到它的文件。
+ *
+ * @author KotoriK
+ */
+
+const now = typeof process !== 'undefined' && process.hrtime && process.hrtime.bigint
+    ? () => Number(process.hrtime.bigint()) / 1e6
+    : () => performance.now()
+
+// 双侧95%的t分布临界值，下标为自由度，30以上按正态近似
+const T95 = [NaN, 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+    2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+    2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042]
+
+function t95(df) {
+    return df < T95.length ? T95[df] : 1.96
+}
+
+function quantile(sorted, q) {
+    if (sorted.length == 0) return NaN
+    const pos = (sorted.length - 1) * q,
+        lo = Math.floor(pos),
+        hi = Math.ceil(pos)
+    return sorted[lo] + (sorted[hi] - sorted[lo]) * (pos - lo)
+}
+
+/**
+ * 对一组样本(ms)做统计
+ *
+ * @param {number[]} samples
+ */
+function summarize(samples) {
+    const sorted = [...samples].sort((x, y) => x - y),
+        n = sorted.length
+    let sum = 0
+    for (const s of sorted) sum += s
+    const mean = sum / n
+    let sq = 0
+    for (const s of sorted) sq += (s - mean) * (s - mean)
+    const sd = n > 1 ? Math.sqrt(sq / (n - 1)) : 0,
+        margin = n > 1 ? t95(n - 1) * sd / Math.sqrt(n) : 0
+    return {
+        samples: n,
+        mean,
+        median: quantile(sorted, 0.5),
+        p95: quantile(sorted, 0.95),
+        min: sorted[0],
+        max: sorted[n - 1],
+        sd,
+        ci95: [mean - margin, mean + margin],
+        rme: mean ? margin / mean * 100 : 0,
+    }
+}
+
+const tick = () => new Promise(resolve => setTimeout(resolve, 0))
+
+/**
+ * 当前已用堆(字节)。Node 下加上 ArrayBuffer 占用，TypedArray 的数据不在 JS 堆里。
+ * 浏览器里只有 Chrome 的 performance.memory，其他返回 NaN
+ */
+function heapUsed() {
+    if (typeof process !== 'undefined' && process.memoryUsage) {
+        const m = process.memoryUsage()
+        return m.heapUsed + m.arrayBuffers
+    }
+    if (typeof performance !== 'undefined' && performance.memory) return performance.memory.usedJSHeapSize
+    return NaN
+}
+
+/**
+ * 用 PerformanceObserver 订阅 'gc' 条目(目前只有 Node 支持)。条目是异步投递的，
+ * stop() 先让出一次事件循环再取
+ */
+function observeGC() {
+    if (typeof PerformanceObserver === 'undefined' ||
+        !(PerformanceObserver.supportedEntryTypes || []).includes('gc')) return null
+    const entries = [],
+        observer = new PerformanceObserver(list => entries.push(...list.getEntries()))
+    observer.observe({ entryTypes: ['gc'] })
+    return {
+        async stop() {
+            await tick()
+            observer.disconnect()
+            return entries
+        }
+    }
+}
+
+// 伪随机序列的默认长度，用例里按 i & (PROBES - 1) 循环取
+const PROBES = 1 << 16
+
+/**
+ * 固定种子的 LCG，每次跑出来的序列一样，用来生成查询顺序、随机优先级等
+ *
+ * @param {number} [length]
+ * @returns {Uint32Array}
+ */
+function randomSequence(length = PROBES) {
+    const out = new Uint32Array(length)
+    let seed = 12345
+    for (let i = 0; i < length; i++) {
+        seed = (Math.imul(seed, 1103515245) + 12345) >>> 0
+        out[i] = seed
+    }
+    return out
+}
+
+/**
+ * 每个附加指标取各次采样的中位数
+ */
+function metricStats(samples) {
+    const out = {}
+    for (const key in samples[0].metrics) {
+        out[key] = quantile(samples.map(s => s.metrics[key]).sort((x, y) => x - y), 0.5)
+    }
+    return out
+}
+
+/**
+ * 汇总每次采样的堆增量，并把落在计时窗口内的GC停顿算到对应采样上
+ *
+ * @param {{heap: number, from: number, to: number}[]} samples
+ * @param {PerformanceEntry[]|null} pauses
+ */
+function memoryStats(samples, pauses) {
+    const heap = samples.map(s => s.heap).sort((x, y) => x - y),
+        stats = { heapDelta: quantile(heap, 0.5), gcCount: NaN, gcTime: NaN, gcMax: NaN }
+    if (pauses) {
+        let count = 0, time = 0, max = 0
+        for (const p of pauses) {
+            if (!samples.some(s => p.startTime >= s.from && p.startTime < s.to)) continue
+            count++
+            time += p.duration
+            max = Math.max(max, p.duration)
+        }
+        stats.gcCount = count / samples.length
+        stats.gcTime = time / samples.length
+        stats.gcMax = max
+    }
+    return stats
+}
+
+class Bench {
+    /**
+     * @param {string} name
+     * @param {object} [options]
+     * @param {number} [options.n] 每次采样的操作数，传给用例的 setup/run
+     * @param {number} [options.warmup] 预热次数
+     * @param {number} [options.samples] 最多采样次数
+     * @param {number} [options.minSamples] 超出时间预算后至少保留的采样次数，单次采样超过 maxTime / minSamples 时相应减少
+     * @param {number} [options.maxTime] 每个用例的时间预算(ms)，含预热、逐次计时和 retained
+     * @param {boolean} [options.latency] 用例提供 op 时，额外跑一遍逐次计时，记录单次操作的最坏延迟
+     * @param {boolean} [options.gc] 每次计时前强制GC，需要 node --expose-gc 或浏览器开 --js-flags=--expose-gc
+     * @param {boolean} [options.memory] 记录每次采样的堆增量、GC 停顿，以及结束后还保留的堆大小(需要 gc()，没有时记为 NaN)
+     */
+    constructor(name, options = {}) {
+        this.name = name
+        this.options = Object.assign({
+            n: 100000,
+            warmup: 3,
+            samples: 30,
+            minSamples: 5,
+            maxTime: 5000,
+            latency: true,
+            gc: false,
+            memory: true,
+        }, options)
+        this.cases = []
+        this.sink = undefined
+    }
+
+    /**
+     * 注册用例。fn 可以是 (n) => any，也可以是 { setup(n), run(state, n), op(state, i), teardown(state, ret) }，
+     * setup 的返回值在每次采样前重新生成，不计入时间。setup/run 可以返回 Promise。
+     * teardown 在计时结束后调用，用来释放 run 产生的资源。
+     * metrics(state, ret) 在计时结束后、teardown 之前调用，返回 { 名字: 数值 } 的附加指标(可以是 Promise)，
+     * 结果里按采样取中位数，放在 result.metrics。
+     * op 是 run 循环体里的单次操作，只用于逐次计时的延迟统计，吞吐量仍以 run 为准。
+     * 逐次计时结束后同样调用 teardown，这时 ret 是最后一次 op 的返回值。
+     *
+     * @param {string} name
+     * @param {Function|{setup?: Function, run: Function}} fn
+     * @param {object} [options] 覆盖 Bench 的同名选项
+     */
+    add(name, fn, options = {}) {
+        const def = typeof fn === 'function' ? { run: (_, n) => fn(n) } : fn
+        this.cases.push(Object.assign({ name, options }, def))
+        return this
+    }
+
+    collect() {
+        if (this.options.gc && typeof gc === 'function') gc()
+    }
+
+    async sample(c, n) {
+        let state = c.setup ? c.setup(n) : undefined
+        if (state && typeof state.then === 'function') state = await state
+        this.collect()
+        const heap = heapUsed(),
+            from = performance.now(),
+            start = now()
+        let ret = c.run(state, n)
+        if (ret && typeof ret.then === 'function') ret = await ret
+        const elapsed = now() - start,
+            to = performance.now(),
+            delta = heapUsed() - heap
+        this.sink = ret
+        const metrics = c.metrics ? await c.metrics(state, ret) : undefined
+        if (c.teardown) await c.teardown(state, ret)
+        return { elapsed, heap: delta, from, to, metrics }
+    }
+
+    async latency(c, n) {
+        const times = new Float64Array(n)
+        let state = c.setup ? c.setup(n) : undefined,
+            ret
+        if (state && typeof state.then === 'function') state = await state
+        this.collect()
+        for (let i = 0; i < n; i++) {
+            const start = now()
+            ret = c.op(state, i)
+            times[i] = now() - start
+        }
+        this.sink = ret
+        if (c.teardown) await c.teardown(state, ret)
+        times.sort()
+        return { worst: times[n - 1], p999: quantile(times, 0.999) }
+    }
+
+    /**
+     * 跑一次完整的 setup+run，前后各强制GC一次，差值就是结果(含 setup 的容器)还占着的堆。
+     * 没有 gc() 时不强制回收的差值没有意义，不跑这一轮，bytes 记为 NaN
+     */
+    async retained(c, n) {
+        const forced = typeof gc === 'function'
+        if (!forced) return { bytes: NaN, forced }
+        // 上一次采样的返回值还挂在 sink 上，不放掉的话会在这里被算成负的
+        this.sink = null
+        gc()
+        const before = heapUsed()
+        let state = c.setup ? c.setup(n) : undefined
+        if (state && typeof state.then === 'function') state = await state
+        let ret = c.run(state, n)
+        if (ret && typeof ret.then === 'function') ret = await ret
+        gc()
+        const bytes = heapUsed() - before
+        this.sink = [state, ret]
+        if (c.teardown) await c.teardown(state, ret)
+        return { bytes, forced }
+    }
+
+    async runCase(c) {
+        const o = Object.assign({}, this.options, c.options),
+            n = o.n
+        // 预热、采样、逐次计时和 retained 都算进 maxTime。GC 停顿只统计落在采样窗口里的，预热时就开始订阅
+        const begin = now(),
+            observer = o.memory ? observeGC() : null,
+            samples = [],
+            wantLatency = o.latency && c.op && n > 0,
+            // 采样之后还要各跑一整轮的附加测量，先给它们留出时间
+            passes = (wantLatency ? 1 : 0) + (o.memory && typeof gc === 'function' ? 1 : 0)
+        for (let i = 0; i < o.warmup; i++) {
+            const s = await this.sample(c, n)
+            // 一次就超出预算的用例预热没有意义，这一次直接当作采样
+            if (s.elapsed > o.maxTime) samples.push(s)
+            if (s.elapsed > o.maxTime / 10) break
+        }
+        while (samples.length < o.samples) {
+            if (samples.length) {
+                // 单次越慢，至少保留的次数越少：minSamples 次最多占满预算，但至少1次
+                const last = samples[samples.length - 1].elapsed,
+                    floor = Math.min(o.minSamples, Math.max(1, Math.floor(o.maxTime / last)))
+                if (samples.length >= floor && now() - begin + last * (1 + passes) > o.maxTime) break
+            }
+            samples.push(await this.sample(c, n))
+        }
+        const times = samples.map(s => s.elapsed),
+            result = Object.assign({ name: c.name, n }, summarize(times))
+        result.opsPerSec = n / result.median * 1000
+        result.perOp = result.median / n
+        if (c.metrics) result.metrics = metricStats(samples)
+        // 剩下的预算不够再跑一轮时跳过
+        const fits = () => now() - begin + result.median <= o.maxTime
+        if (wantLatency && fits()) result.latency = await this.latency(c, n)
+        if (o.memory) {
+            const pauses = observer ? await observer.stop() : null
+            result.memory = memoryStats(samples, pauses)
+            result.memory.retained = fits() ? await this.retained(c, n) : { bytes: NaN, forced: false }
+        }
+        this.sink = undefined
+        result.wall = now() - begin
+        result.raw = times
+        return result
+    }
+
+    /**
+     * 依次运行所有用例
+     *
+     * @param {string[]} [only] 只运行这些名字的用例
+     * @returns {Promise<object[]>}
+     */
+    async run(only) {
+        const results = []
+        for (const c of this.cases) {
+            if (only && !only.includes(c.name)) continue
+            results.push(await this.runCase(c))
+            await tick()
+        }
+        return results
+    }
+}
+
+function fmt(ms) {
+    return ms < 1 ? ms.toFixed(4) : ms < 100 ? ms.toFixed(3) : ms.toFixed(1)
+}
+
+function fmtOps(ops) {
+    return ops >= 1e6 ? (ops / 1e6).toFixed(1) + 'M' : ops >= 1e3 ? (ops / 1e3).toFixed(1) + 'k' : ops.toFixed(0)
+}
+
+function fmtBytes(b) {
+    if (isNaN(b)) return '?'
+    const abs = Math.abs(b)
+    return abs >= 1048576 ? (b / 1048576).toFixed(1) + 'MB' : abs >= 1024 ? (b / 1024).toFixed(1) + 'KB' : b + 'B'
+}
+
+function format(r) {
+    let line = `${r.name}: median ${fmt(r.median)}ms p95 ${fmt(r.p95)}ms ` +
+        `mean ${fmt(r.mean)}ms ±${r.rme.toFixed(1)}% (95% CI ${fmt(r.ci95[0])}..${fmt(r.ci95[1])}) ` +
+        `sd ${fmt(r.sd)}ms n=${r.n} x${r.samples} ${fmtOps(r.opsPerSec)}ops/s ${(r.perOp * 1e3).toFixed(3)}µs/op`
+    if (r.latency) line += ` worst ${fmt(r.latency.worst)}ms p99.9 ${fmt(r.latency.p999)}ms`
+    for (const key in r.metrics) line += ` ${key}=${+r.metrics[key].toFixed(4)}`
+    if (r.memory) {
+        const m = r.memory
+        line += ` heapΔ ${fmtBytes(m.heapDelta)}`
+        if (!isNaN(m.gcCount)) line += ` gc ${m.gcCount.toFixed(1)}x/${fmt(m.gcTime)}ms (max ${fmt(m.gcMax)}ms)`
+        line += ` retained ${fmtBytes(m.retained.bytes)}`
+    }
+    return line
+}
+
+function report(results) {
+    for (const r of results) console.log(format(r))
+}
+
+/**
+ * 运行环境信息，写进结果里，换引擎版本或机器时对比才有依据
+ */
+function environment() {
+    if (typeof process !== 'undefined' && process.versions && process.versions.node) {
+        const os = require('os'),
+            cpus = os.cpus()
+        return {
+            engine: 'node',
+            version: process.version,
+            v8: process.versions.v8,
+            platform: process.platform,
+            arch: process.arch,
+            cpu: cpus.length ? cpus[0].model : 'unknown',
+            cores: cpus.length,
+            memory: os.totalmem(),
+            flags: process.execArgv.concat(process.env.NODE_OPTIONS ? [process.env.NODE_OPTIONS] : []),
+        }
+    }
+    return {
+        engine: 'browser',
+        userAgent: navigator.userAgent,
+        cores: navigator.hardwareConcurrency,
+        memory: navigator.deviceMemory,
+        flags: [],
+    }
+}
+
+/**
+ * 结果转成可保存的 JSON 对象，供 harness/compare.js 和基线对比
+ *
+ * @param {string} suite
+ * @param {object[]} results
+ */
+function toJSON(suite, results) {
+    return {
+        suite,
+        date: new Date().toISOString(),
+        env: environment(),
+        results,
+    }
+}
+
+if (typeof module !== 'undefined') {
+    module.exports = { Bench, summarize, quantile, now, heapUsed, PROBES, randomSequence, format, report, environment, toJSON }
+}
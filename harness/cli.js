@@ -0,0 +1,39 @@
+/**
+ * 命令行脚本共用的小工具，只在 Node 下使用
+ *
+ * @author KotoriK
+ */
+const fs = require('fs')
+const path = require('path')
+
+/**
+ * --key value 形式的参数解析，其余的放进 _
+ *
+ * @param {string[]} argv
+ */
+function parseArgs(argv) {
+    const args = { _: [] }
+    for (let i = 0; i < argv.length; i++) {
+        if (argv[i].startsWith('--')) {
+            const key = argv[i].slice(2)
+            args[key] = i + 1 < argv.length && !argv[i + 1].startsWith('--') ? argv[++i] : true
+        } else {
+            args._.push(argv[i])
+        }
+    }
+    return args
+}
+
+function loadSuite(file) {
+    return require(path.resolve(file))
+}
+
+function writeJSON(file, data) {
+    fs.writeFileSync(file, JSON.stringify(data, null, 2) + '\n')
+}
+
+function readJSON(file) {
+    return JSON.parse(fs.readFileSync(file, 'utf8'))
+}
+
+module.exports = { parseArgs, loadSuite, writeJSON, readJSON }
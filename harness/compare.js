@@ -0,0 +1,102 @@
+/**
+ * 把一次运行的 JSON 结果和基线对比。同名同 n 的用例用 Mann-Whitney U 检验原始样本，
+ * p < alpha 且中位数变慢超过 threshold% 才算回归；有回归时退出码为1，可以直接拿来卡引擎升级。
+ * 计时样本一般是右偏的，用秩检验比 t 检验稳。
+ *
+ * 用法: node harness/compare.js baseline.json current.json [--threshold 5] [--alpha 0.05]
+ *
+ * @author KotoriK
+ */
+const cli = require('./cli')
+
+// 标准正态分布函数，Abramowitz-Stegun 7.1.26 近似 erf
+function normalCdf(z) {
+    const x = Math.abs(z) / Math.SQRT2,
+        t = 1 / (1 + 0.3275911 * x),
+        erf = 1 - t * (0.254829592 + t * (-0.284496736 + t * (1.421413741 + t * (-1.453152027 + t * 1.061405429)))) * Math.exp(-x * x)
+    return z >= 0 ? (1 + erf) / 2 : (1 - erf) / 2
+}
+
+/**
+ * 双侧 Mann-Whitney U 检验(正态近似，含并列修正)
+ *
+ * @param {number[]} a
+ * @param {number[]} b
+ * @returns {number} p 值
+ */
+function mannWhitney(a, b) {
+    const n1 = a.length,
+        n2 = b.length,
+        all = a.map(v => [v, 0]).concat(b.map(v => [v, 1])).sort((x, y) => x[0] - y[0]),
+        n = n1 + n2
+    let r1 = 0, ties = 0
+    for (let i = 0; i < n;) {
+        let j = i
+        while (j + 1 < n && all[j + 1][0] == all[i][0]) j++
+        const rank = (i + j) / 2 + 1,
+            t = j - i + 1
+        ties += t * t * t - t
+        for (let k = i; k <= j; k++) {
+            if (all[k][1] == 0) r1 += rank
+        }
+        i = j + 1
+    }
+    const u = r1 - n1 * (n1 + 1) / 2,
+        mu = n1 * n2 / 2,
+        sigma = Math.sqrt(n1 * n2 / 12 * (n + 1 - ties / (n * (n - 1))))
+    if (sigma == 0) return 1
+    return 2 * (1 - normalCdf(Math.abs(u - mu) / sigma))
+}
+
+/**
+ * @param {object} baseline harness.toJSON 的结果
+ * @param {object} current
+ * @param {object} [options]
+ */
+function compare(baseline, current, options = {}) {
+    const threshold = options.threshold === undefined ? 5 : options.threshold,
+        alpha = options.alpha === undefined ? 0.05 : options.alpha,
+        base = new Map(baseline.results.map(r => [`${r.name}@${r.n}`, r])),
+        rows = []
+    for (const r of current.results) {
+        const b = base.get(`${r.name}@${r.n}`)
+        if (!b) continue
+        const change = (r.median - b.median) / b.median * 100,
+            p = b.raw && r.raw ? mannWhitney(b.raw, r.raw) : NaN,
+            significant = p < alpha && Math.abs(change) > threshold
+        rows.push({
+            name: r.name,
+            n: r.n,
+            base: b.median,
+            current: r.median,
+            change,
+            p,
+            status: !significant ? 'same' : change > 0 ? 'regression' : 'improvement',
+        })
+    }
+    return rows
+}
+
+function describeEnv(env) {
+    return env.engine == 'node' ? `node ${env.version} (v8 ${env.v8}) ${env.cpu} ${env.flags.join(' ')}` : env.userAgent
+}
+
+if (require.main === module) {
+    const args = cli.parseArgs(process.argv.slice(2)),
+        baseline = cli.readJSON(args._[0]),
+        current = cli.readJSON(args._[1])
+    const rows = compare(baseline, current, {
+        threshold: args.threshold === undefined ? undefined : +args.threshold,
+        alpha: args.alpha === undefined ? undefined : +args.alpha,
+    })
+    console.log(`baseline: ${describeEnv(baseline.env)}`)
+    console.log(`current:  ${describeEnv(current.env)}`)
+    for (const r of rows) {
+        const sign = r.change >= 0 ? '+' : ''
+        console.log(`${r.status == 'regression' ? '!!' : '  '} ${r.name}@${r.n}: ${r.base.toFixed(4)}ms -> ${r.current.toFixed(4)}ms ` +
+            `(${sign}${r.change.toFixed(1)}%, p=${r.p.toFixed(3)}) ${r.status}`)
+    }
+    if (rows.some(r => r.status == 'regression')) process.exitCode = 1
+}
+
+module.exports = { compare, mannWhitney }
@@ -0,0 +1,500 @@
+/**
+ * 给 Node 用的最小 DOM 实现，只覆盖 dom/ 下的基准用到的接口：
+ * createElement/cloneNode/template/DocumentFragment/innerHTML、属性读写、
+ * 节点树操作、customElements.define、attachShadow 和 connectedCallback/disconnectedCallback。
+ * 它只是让基准能在 CI 里离线跑起来、对比各写法在 JS 层面的开销，绝对数字和浏览器没有可比性。
+ *
+ * @author KotoriK
+ */
+const VOID_ELEMENTS = new Set(['area', 'base', 'br', 'col', 'embed', 'hr', 'img', 'input', 'link', 'meta', 'source', 'track', 'wbr'])
+
+// 属性和特性同名反射的那些
+const REFLECTED = { id: 'id', className: 'class', src: 'src', title: 'title', slot: 'slot' }
+
+// 事件直接用 Node 自带的 EventTarget/Event，已经支持 once 和 signal
+class Node extends EventTarget {
+    constructor(ownerDocument) {
+        super()
+        this.ownerDocument = ownerDocument
+        this.parentNode = null
+        this.firstChild = null
+        this.lastChild = null
+        this.previousSibling = null
+        this.nextSibling = null
+    }
+
+    get childNodes() {
+        const out = []
+        for (let n = this.firstChild; n; n = n.nextSibling) out.push(n)
+        return out
+    }
+
+    get isConnected() {
+        let n = this
+        while (n.parentNode || n.host) n = n.parentNode || n.host
+        return n === this.ownerDocument
+    }
+
+    appendChild(child) {
+        return this.insertBefore(child, null)
+    }
+
+    insertBefore(child, ref) {
+        if (child.nodeType == 11) {
+            while (child.firstChild) this.insertBefore(child.firstChild, ref)
+            return child
+        }
+        if (child.parentNode) child.parentNode.removeChild(child)
+        child.parentNode = this
+        child.nextSibling = ref
+        child.previousSibling = ref ? ref.previousSibling : this.lastChild
+        if (child.previousSibling) child.previousSibling.nextSibling = child
+        else this.firstChild = child
+        if (ref) ref.previousSibling = child
+        else this.lastChild = child
+        if (registry.definitions.size && this.isConnected) lifecycle(child, 'connectedCallback')
+        return child
+    }
+
+    removeChild(child) {
+        if (child.parentNode !== this) throw new Error('NotFoundError: not a child of this node')
+        const connected = registry.definitions.size && child.isConnected
+        if (child.previousSibling) child.previousSibling.nextSibling = child.nextSibling
+        else this.firstChild = child.nextSibling
+        if (child.nextSibling) child.nextSibling.previousSibling = child.previousSibling
+        else this.lastChild = child.previousSibling
+        child.parentNode = child.previousSibling = child.nextSibling = null
+        if (connected) lifecycle(child, 'disconnectedCallback')
+        return child
+    }
+
+    remove() {
+        if (this.parentNode) this.parentNode.removeChild(this)
+    }
+
+    replaceChildren(...nodes) {
+        while (this.firstChild) this.removeChild(this.firstChild)
+        for (const n of nodes) this.appendChild(typeof n === 'string' ? this.ownerDocument.createTextNode(n) : n)
+    }
+
+    append(...nodes) {
+        for (const n of nodes) this.appendChild(typeof n === 'string' ? this.ownerDocument.createTextNode(n) : n)
+    }
+
+    get children() {
+        const out = []
+        for (let n = this.firstChild; n; n = n.nextSibling) {
+            if (n.nodeType == 1) out.push(n)
+        }
+        return out
+    }
+
+    get textContent() {
+        let text = ''
+        for (let n = this.firstChild; n; n = n.nextSibling) text += n.textContent
+        return text
+    }
+
+    set textContent(value) {
+        this.replaceChildren()
+        if (value) this.appendChild(this.ownerDocument.createTextNode(String(value)))
+    }
+
+    cloneChildren(into) {
+        for (let n = this.firstChild; n; n = n.nextSibling) into.appendChild(n.cloneNode(true))
+        return into
+    }
+}
+
+class Text extends Node {
+    constructor(ownerDocument, data) {
+        super(ownerDocument)
+        this.nodeType = 3
+        this.data = data
+    }
+
+    get textContent() {
+        return this.data
+    }
+
+    cloneNode() {
+        return new Text(this.ownerDocument, this.data)
+    }
+}
+
+class DocumentFragment extends Node {
+    constructor(ownerDocument) {
+        super(ownerDocument)
+        this.nodeType = 11
+    }
+
+    cloneNode(deep) {
+        const copy = new DocumentFragment(this.ownerDocument)
+        return deep ? this.cloneChildren(copy) : copy
+    }
+}
+
+class ShadowRoot extends DocumentFragment {
+    constructor(host, mode) {
+        super(host.ownerDocument)
+        this.host = host
+        this.mode = mode
+    }
+
+    get innerHTML() {
+        let html = ''
+        for (let n = this.firstChild; n; n = n.nextSibling) html += serialize(n)
+        return html
+    }
+
+    set innerHTML(html) {
+        this.replaceChildren()
+        parseInto(this.ownerDocument, html, this)
+    }
+}
+
+class Element extends Node {
+    constructor(ownerDocument, localName) {
+        super(ownerDocument)
+        this.nodeType = 1
+        this.localName = localName
+        this.attrs = new Map()
+        this.style = {}
+        this.shadow = null
+    }
+
+    get tagName() {
+        return this.localName.toUpperCase()
+    }
+
+    get attributes() {
+        const out = []
+        for (const [name, value] of this.attrs) out.push({ name, value })
+        return out
+    }
+
+    getAttribute(name) {
+        const v = this.attrs.get(name)
+        return v === undefined ? null : v
+    }
+
+    setAttribute(name, value) {
+        const old = this.getAttribute(name)
+        value = String(value)
+        this.attrs.set(name, value)
+        this.attributeChanged(name, old, value)
+    }
+
+    removeAttribute(name) {
+        if (!this.attrs.has(name)) return
+        const old = this.attrs.get(name)
+        this.attrs.delete(name)
+        this.attributeChanged(name, old, null)
+    }
+
+    hasAttribute(name) {
+        return this.attrs.has(name)
+    }
+
+    // 子类用来响应属性变化，比如媒体元素的 src
+    attributeChanged() { }
+
+    attachShadow(init) {
+        if (this.shadow) throw new Error('NotSupportedError: shadow root already attached')
+        this.shadow = new ShadowRoot(this, init.mode)
+        return this.shadow
+    }
+
+    get shadowRoot() {
+        return this.shadow && this.shadow.mode == 'open' ? this.shadow : null
+    }
+
+    cloneNode(deep) {
+        const copy = this.ownerDocument.createElement(this.localName)
+        for (const [name, value] of this.attrs) copy.attrs.set(name, value)
+        return deep ? this.cloneChildren(copy) : copy
+    }
+
+    get innerHTML() {
+        let html = ''
+        for (let n = this.firstChild; n; n = n.nextSibling) html += serialize(n)
+        return html
+    }
+
+    set innerHTML(html) {
+        this.replaceChildren()
+        parseInto(this.ownerDocument, html, this)
+    }
+
+    get outerHTML() {
+        return serialize(this)
+    }
+
+    // 没有布局，读这些只是为了让"强制布局"的代码能跑
+    get offsetHeight() {
+        return 0
+    }
+
+    get offsetWidth() {
+        return 0
+    }
+
+    getBoundingClientRect() {
+        return { x: 0, y: 0, width: 0, height: 0, top: 0, left: 0, right: 0, bottom: 0 }
+    }
+}
+
+for (const prop in REFLECTED) {
+    const attr = REFLECTED[prop]
+    Object.defineProperty(Element.prototype, prop, {
+        get() {
+            const v = this.getAttribute(attr)
+            return v === null ? '' : v
+        },
+        set(value) {
+            this.setAttribute(attr, value)
+        },
+        configurable: true,
+    })
+}
+
+class HTMLElement extends Element {
+    // 自定义元素由 new 直接构造时不带参数，文档和标签名从注册表里找
+    constructor(ownerDocument, localName) {
+        super(ownerDocument || registry.document, localName || registry.names.get(new.target))
+    }
+}
+
+class HTMLTemplateElement extends HTMLElement {
+    constructor(ownerDocument, localName) {
+        super(ownerDocument, localName)
+        this.content = new DocumentFragment(ownerDocument)
+    }
+
+    get innerHTML() {
+        let html = ''
+        for (let n = this.content.firstChild; n; n = n.nextSibling) html += serialize(n)
+        return html
+    }
+
+    set innerHTML(html) {
+        this.content.replaceChildren()
+        parseInto(this.ownerDocument, html, this.content)
+    }
+
+    cloneNode(deep) {
+        const copy = super.cloneNode(false)
+        if (deep) this.content.cloneChildren(copy.content)
+        return copy
+    }
+}
+
+class HTMLMediaElement extends HTMLElement {
+    constructor(ownerDocument, localName) {
+        super(ownerDocument, localName)
+        this.paused = true
+        this.networkState = 0
+    }
+
+    pause() {
+        this.paused = true
+    }
+
+    play() {
+        this.paused = false
+        return Promise.resolve()
+    }
+
+    load() {
+        this.networkState = this.hasAttribute('src') ? 2 : 0
+    }
+
+    // 和浏览器一样，设置 src(哪怕值没变)就重新走加载流程，异步派发 loadstart
+    attributeChanged(name, old, value) {
+        if (name != 'src' || value === null) return
+        this.networkState = 2
+        setTimeout(() => this.dispatchEvent(new Event('loadstart')), 0)
+    }
+}
+
+class HTMLAudioElement extends HTMLMediaElement { }
+
+class HTMLVideoElement extends HTMLMediaElement { }
+
+class HTMLImageElement extends HTMLElement { }
+
+/**
+ * 只支持自主自定义元素(class extends HTMLElement)，不支持 is= 的内置元素扩展
+ */
+class CustomElementRegistry {
+    constructor(document) {
+        this.document = document
+        this.definitions = new Map()
+        this.names = new Map()
+    }
+
+    define(name, constructor) {
+        if (!/^[a-z][a-z0-9._]*-[a-z0-9._-]*$/.test(name)) throw new SyntaxError(`'${name}' is not a valid custom element name`)
+        if (this.definitions.has(name)) throw new Error(`NotSupportedError: '${name}' has already been defined`)
+        this.definitions.set(name, constructor)
+        this.names.set(constructor, name)
+    }
+
+    get(name) {
+        return this.definitions.get(name)
+    }
+}
+
+let registry = new CustomElementRegistry(null)
+
+// 节点进出文档时，对子树(包括 shadow 树)里的自定义元素调用对应的回调
+function lifecycle(node, callback) {
+    if (node.nodeType != 1) return
+    if (typeof node[callback] === 'function') node[callback]()
+    for (let n = node.firstChild; n; n = n.nextSibling) lifecycle(n, callback)
+    if (node.shadow) {
+        for (let n = node.shadow.firstChild; n; n = n.nextSibling) lifecycle(n, callback)
+    }
+}
+
+const ELEMENT_CLASSES = {
+    template: HTMLTemplateElement,
+    audio: HTMLAudioElement,
+    video: HTMLVideoElement,
+    img: HTMLImageElement,
+}
+
+class Document extends Node {
+    constructor() {
+        super(null)
+        this.nodeType = 9
+        this.documentElement = this.createElement('html')
+        this.head = this.createElement('head')
+        this.body = this.createElement('body')
+        this.documentElement.appendChild(this.head)
+        this.documentElement.appendChild(this.body)
+        this.appendChild(this.documentElement)
+    }
+
+    createElement(tagName) {
+        const name = String(tagName).toLowerCase(),
+            Type = ELEMENT_CLASSES[name] || registry.get(name) || HTMLElement
+        return new Type(this, name)
+    }
+
+    createTextNode(data) {
+        return new Text(this, String(data))
+    }
+
+    createDocumentFragment() {
+        return new DocumentFragment(this)
+    }
+
+    importNode(node, deep) {
+        return node.cloneNode(deep)
+    }
+}
+
+// Document 构造时 ownerDocument 还没有，这里补上
+Object.defineProperty(Document.prototype, 'ownerDocument', {
+    get() { return this },
+    set() { },
+})
+
+function escapeText(s) {
+    return s.replace(/&/g, '&amp;').replace(/</g, '&lt;').replace(/>/g, '&gt;')
+}
+
+function serialize(node) {
+    if (node.nodeType == 3) return escapeText(node.data)
+    let html = '<' + node.localName
+    for (const [name, value] of node.attrs) html += ` ${name}="${value.replace(/&/g, '&amp;').replace(/"/g, '&quot;')}"`
+    html += '>'
+    if (VOID_ELEMENTS.has(node.localName)) return html
+    return html + node.innerHTML + `</${node.localName}>`
+}
+
+const TAG = /<(\/?)([a-zA-Z][\w-]*)((?:\s+[^\s=>\/]+(?:\s*=\s*(?:"[^"]*"|'[^']*'|[^\s>]+))?)*)\s*(\/?)>/g
+const ATTR = /([^\s=>\/]+)(?:\s*=\s*(?:"([^"]*)"|'([^']*)'|([^\s>]+)))?/g
+
+function unescape(s) {
+    return s.replace(/&lt;/g, '<').replace(/&gt;/g, '>').replace(/&quot;/g, '"').replace(/&#39;/g, "'").replace(/&amp;/g, '&')
+}
+
+/**
+ * 够用就好的 HTML 解析：标签、属性、文本，不处理注释和脚本
+ */
+function parseInto(doc, html, root) {
+    const stack = [root]
+    let last = 0, m
+    TAG.lastIndex = 0
+    while ((m = TAG.exec(html))) {
+        const top = stack[stack.length - 1],
+            into = top.content || top
+        if (m.index > last) into.appendChild(doc.createTextNode(unescape(html.slice(last, m.index))))
+        last = TAG.lastIndex
+        const name = m[2].toLowerCase()
+        if (m[1]) {
+            for (let i = stack.length - 1; i > 0; i--) {
+                if (stack[i].localName == name) {
+                    stack.length = i
+                    break
+                }
+            }
+            continue
+        }
+        const el = doc.createElement(name)
+        let a
+        ATTR.lastIndex = 0
+        while ((a = ATTR.exec(m[3]))) {
+            const v = a[2] !== undefined ? a[2] : a[3] !== undefined ? a[3] : a[4] !== undefined ? a[4] : ''
+            el.attrs.set(a[1].toLowerCase(), unescape(v))
+        }
+        into.appendChild(el)
+        if (!m[4] && !VOID_ELEMENTS.has(name)) stack.push(el)
+    }
+    if (last < html.length) {
+        const top = stack[stack.length - 1]
+        ;(top.content || top).appendChild(doc.createTextNode(unescape(html.slice(last))))
+    }
+}
+
+/**
+ * 把 document 和常用的 DOM 构造函数挂到 global 上，已经有 document 时什么都不做
+ *
+ * @param {object} global
+ * @returns {Document}
+ */
+function install(global) {
+    if (global.document) return global.document
+    const document = new Document()
+    registry = new CustomElementRegistry(document)
+    if (!global.getComputedStyle) {
+        global.getComputedStyle = el => Object.assign({
+            display: el.localName == 'div' ? 'block' : 'inline',
+            getPropertyValue(name) { return this[name] || '' },
+        }, el.style)
+    }
+    if (!global.requestAnimationFrame) {
+        global.requestAnimationFrame = cb => setTimeout(() => cb(performance.now()), 16)
+        global.cancelAnimationFrame = id => clearTimeout(id)
+    }
+    Object.assign(global, {
+        document,
+        customElements: registry,
+        Node,
+        Element,
+        HTMLElement,
+        HTMLTemplateElement,
+        HTMLMediaElement,
+        HTMLAudioElement,
+        HTMLVideoElement,
+        HTMLImageElement,
+        DocumentFragment,
+        ShadowRoot,
+        Text,
+    })
+    return document
+}
+
+module.exports = { install, Document, Element, HTMLElement }
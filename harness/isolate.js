@@ -0,0 +1,63 @@
+/**
+ * 每个用例单独 fork 一个新的 Node 进程跑，堆、JIT 反馈和 GC 状态都不跨用例，
+ * 避免前面用例留下的大 Set/数组影响后面的数字。--gc 时子进程带 --expose-gc，每次计时前强制回收。
+ * 其余参数原样传给 harness/run.js。
+ *
+ * 用法: node harness/isolate.js genic/array-set.js [--gc] [--n 100000] [--only "..."] [--json out.json]
+ *
+ * @author KotoriK
+ */
+const { fork } = require('child_process')
+const path = require('path')
+const cli = require('./cli')
+
+function runChild(argv, execArgv) {
+    return new Promise((resolve, reject) => {
+        let doc
+        const child = fork(path.join(__dirname, 'run.js'), argv, { execArgv })
+        child.on('message', m => doc = m)
+        child.on('error', reject)
+        child.on('exit', code => {
+            if (code == 0 && doc) resolve(doc)
+            else reject(new Error(`case ${argv[argv.length - 1]} exited with ${code}`))
+        })
+    })
+}
+
+/**
+ * 用例名交给子进程列: 套件的 register 可能要 DOM 替身和 prepare 准备好的 context
+ */
+async function caseNames(passthrough) {
+    const { names } = await runChild(passthrough.concat(['--list']), [])
+    return names
+}
+
+async function main(argv) {
+    const args = cli.parseArgs(argv)
+    // 去掉父进程自己处理的参数，剩下的透传
+    const passthrough = []
+    for (let i = 0; i < argv.length; i++) {
+        if (argv[i] == '--json' || argv[i] == '--only') i++
+        else passthrough.push(argv[i])
+    }
+    const names = args.only ? args.only.split(',') : await caseNames(passthrough)
+    const execArgv = args.gc ? ['--expose-gc'] : []
+    let merged
+    for (const name of names) {
+        const doc = await runChild(passthrough.concat(['--only', name]), execArgv)
+        if (!merged) merged = Object.assign({}, doc, { results: [] })
+        merged.results.push(...doc.results)
+    }
+    merged.env.isolated = true
+    if (args.json) cli.writeJSON(args.json, merged)
+    return merged
+}
+
+if (require.main === module) {
+    main(process.argv.slice(2)).catch(e => {
+        console.error(e)
+        process.exitCode = 1
+    })
+}
+
+module.exports = { main }
@@ -0,0 +1,67 @@
+/**
+ * 在 Node 下运行一个套件并输出 JSON 结果。套件需要导出 register(bench, context)，
+ * 可选导出 prepare(args) 异步准备 context(比如要先 fetch 的资源)，defaults 覆盖 Bench 的默认选项。
+ * 导出 needsDOM 的套件在没有 document 时装上 harness/dom-shim.js；它和导出 needsServer 的套件都会起一个本地静态服务，
+ * 用 --file 指定测试文件，或 --size 指定生成的字节数，也可以直接给 --url。
+ *
+ * 用法: node harness/run.js genic/array-set.js [--n 100000] [--samples 30] [--only "set add,array push"] [--gc] [--json out.json]
+ *       node harness/run.js dom/htmlelement.js [--file test.mp3 | --size 1048576 | --url http://...]
+ *       node harness/run.js dom/htmlelement.js --list   只列出用例名，不运行(DOM 替身、静态服务和 prepare 照常准备)
+ *
+ * @author KotoriK
+ */
+const path = require('path')
+const harness = require('./bench')
+const cli = require('./cli')
+
+const OPTIONS = ['n', 'warmup', 'samples', 'minSamples', 'maxTime']
+
+async function main(argv) {
+    const args = cli.parseArgs(argv),
+        file = args._[0],
+        suite = cli.loadSuite(file),
+        name = path.relative(path.resolve(__dirname, '..'), path.resolve(file)).replace(/\.js$/, '')
+    const options = {}
+    for (const k of OPTIONS) {
+        if (args[k] !== undefined) options[k] = +args[k]
+    }
+    if (args.latency === 'false') options.latency = false
+    if (args.gc) options.gc = true
+    // DOM 套件在 Node 下用内置的 DOM 替身，测试资源由本地静态服务提供
+    let server
+    if (suite.needsDOM) require('./dom-shim').install(globalThis)
+    if ((suite.needsDOM || suite.needsServer) && !args.url) {
+        server = await require('./static-server').serve({ file: args.file, size: args.size && +args.size })
+        args.url = server.url
+        // 本地服务支持 ?size= 按需生成指定大小的数据
+        args.sizable = !args.file
+    }
+    const context = suite.prepare ? await suite.prepare(args) : args
+    const bench = new harness.Bench(name, Object.assign({}, suite.defaults, options))
+    suite.register(bench, context)
+    const results = args.list ? null : await bench.run(args.only ? args.only.split(',') : undefined)
+    if (suite.cleanup) await suite.cleanup(context)
+    if (server) await server.close()
+    if (args.list) {
+        const names = bench.cases.map(c => c.name)
+        // harness/isolate.js 用这个拿到用例列表
+        if (process.send) process.send({ names })
+        else console.log(names.join('\n'))
+        return names
+    }
+    harness.report(results)
+    const doc = harness.toJSON(name, results)
+    if (args.json) cli.writeJSON(args.json, doc)
+    // 被 harness/isolate.js fork 出来时把结果传回父进程
+    if (process.send) process.send(doc)
+    return doc
+}
+
+if (require.main === module) {
+    main(process.argv.slice(2)).catch(e => {
+        console.error(e)
+        process.exitCode = 1
+    })
+}
+
+module.exports = { main }
@@ -0,0 +1,54 @@
+/**
+ * 只监听 127.0.0.1 的静态文件服务，给 DOM 基准提供测试用的资源，不依赖外网。
+ * /blob 返回指定文件；没有文件时返回生成的数据，大小由 ?size= 决定(默认 size 选项)。
+ *
+ * @author KotoriK
+ */
+const http = require('http')
+const fs = require('fs')
+
+function generate(size) {
+    const buffer = Buffer.allocUnsafe(size)
+    for (let i = 0; i < size; i++) buffer[i] = (i * 31) & 0xff
+    return buffer
+}
+
+/**
+ * @param {object} [options]
+ * @param {string} [options.file] 要提供的本地文件
+ * @param {number} [options.size] 没有文件时默认生成的字节数
+ * @param {string} [options.type] Content-Type
+ * @returns {Promise<{url: string, close: () => Promise<void>}>}
+ */
+function serve(options = {}) {
+    const type = options.type || 'application/octet-stream',
+        fixed = options.file ? fs.readFileSync(options.file) : null,
+        cache = new Map()
+    const server = http.createServer((req, res) => {
+        const url = new URL(req.url, 'http://127.0.0.1')
+        if (url.pathname != '/blob') {
+            res.writeHead(404)
+            res.end()
+            return
+        }
+        let body = fixed
+        if (!body || url.searchParams.has('size')) {
+            const size = +(url.searchParams.get('size') || options.size || 1 << 20)
+            if (!cache.has(size)) cache.set(size, generate(size))
+            body = cache.get(size)
+        }
+        res.writeHead(200, { 'Content-Type': type, 'Content-Length': body.length })
+        res.end(body)
+    })
+    return new Promise((resolve, reject) => {
+        server.on('error', reject)
+        server.listen(0, '127.0.0.1', () => {
+            resolve({
+                url: `http://127.0.0.1:${server.address().port}/blob`,
+                close: () => new Promise(done => server.close(() => done())),
+            })
+        })
+    })
+}
+
+module.exports = { serve }
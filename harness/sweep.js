@@ -0,0 +1,157 @@
+/**
+ * 规模扫描。把同一组用例在 1e2 到 1e7 之间按对数均匀取的规模上各跑一遍，
+ * 用 log-log 最小二乘拟合总耗时随 n 的斜率，判断整个循环是 O(1)、O(n) 还是 O(n²)，
+ * 看 unshift/shift 从哪里开始掉下悬崖。
+ * 预计下一档会超出 caseLimit 的用例不再往上跑，记为 skipped。
+ * 自己覆盖了 n 的用例按实际跑的 n 记录(sweepN 是这一档的规模)，n 不再随扫描增长的点记为 fixed，不参与拟合。
+ *
+ * 用法: node harness/sweep.js genic/array-set.js [--from 100] [--to 1e7] [--steps 2] [--csv out.csv] [--json out.json]
+ *
+ * @author KotoriK
+ */
+const harness = typeof require === 'function' ? require('./bench') : { Bench, environment }
+
+/**
+ * 从 from 到 to 每个数量级取 steps 个点
+ */
+function sizes(from, to, steps) {
+    const out = [],
+        lo = Math.log10(from),
+        hi = Math.log10(to)
+    for (let k = 0; lo + k / steps <= hi + 1e-9; k++) {
+        out.push(Math.round(Math.pow(10, lo + k / steps)))
+    }
+    return out
+}
+
+// 低于这个耗时(ms)的点主要是计时器噪声和解释执行，不参与拟合
+const FIT_FLOOR = 0.1
+
+/**
+ * 对 (n, ms) 点做 log-log 线性回归，返回斜率和对应的复杂度。
+ * 只用规模最大的一半点，小规模时 JIT 还没稳定，会把斜率拉低
+ *
+ * @param {{n: number, median: number}[]} points
+ */
+function fit(points) {
+    let usable = points.filter(p => p.median >= FIT_FLOOR)
+    if (usable.length < 2) usable = points.slice(-2)
+    else usable = usable.slice(-Math.max(3, Math.ceil(usable.length / 2)))
+    if (usable.length < 2) return { slope: NaN, total: '?', perOp: '?' }
+    let sx = 0, sy = 0, sxx = 0, sxy = 0
+    for (const p of usable) {
+        const x = Math.log(p.n), y = Math.log(p.median)
+        sx += x
+        sy += y
+        sxx += x * x
+        sxy += x * y
+    }
+    const k = usable.length,
+        slope = (k * sxy - sx * sy) / (k * sxx - sx * sx)
+    if (slope < 0.5) return { slope, total: 'O(1)', perOp: 'O(1/n)' }
+    // 大规模时缓存未命中和GC会让线性用例的斜率偏到1.5左右，阈值放宽一些
+    if (slope < 1.75) return { slope, total: 'O(n)', perOp: 'O(1)' }
+    return { slope, total: 'O(n²)', perOp: 'O(n)' }
+}
+
+/**
+ * @param {Function} register 套件的 register(bench)
+ * @param {object} [options]
+ * @param {number} [options.from]
+ * @param {number} [options.to]
+ * @param {number} [options.steps] 每个数量级的点数
+ * @param {number} [options.caseLimit] 单次采样预计超过该值(ms)就停止放大规模
+ * @param {object} [options.bench] 传给每一档 Bench 的选项
+ * @returns {Promise<{rows: object[], fits: object[]}>}
+ */
+async function sweep(register, options = {}) {
+    const o = Object.assign({ from: 1e2, to: 1e7, steps: 2, caseLimit: 2000 }, options),
+        rows = [],
+        points = new Map(),
+        latest = new Map(),
+        fixed = new Set(),
+        stopped = new Set()
+    for (const n of sizes(o.from, o.to, o.steps)) {
+        const bench = new harness.Bench('sweep', Object.assign({
+            warmup: 2, samples: 10, minSamples: 3, maxTime: 1000, latency: false,
+        }, o.bench, { n }))
+        register(bench)
+        const only = []
+        for (const c of bench.cases) {
+            if (stopped.has(c.name)) continue
+            const seen = points.get(c.name) || [],
+                last = latest.get(c.name)
+            if (last) {
+                // 规模固定的用例下一档耗时不变，其余按拟合出的斜率外推
+                const growth = fixed.has(c.name) ? 1 : n / last.sweepN,
+                    slope = seen.length > 1 ? Math.max(1, fit(seen).slope || 1) : 2
+                if (last.median * Math.pow(growth, slope) > o.caseLimit) {
+                    stopped.add(c.name)
+                    rows.push({ name: c.name, n, sweepN: n, skipped: true })
+                    continue
+                }
+            }
+            only.push(c.name)
+        }
+        for (const r of await bench.run(only)) {
+            // 用例可以自己覆盖 n(比如 { n: size } 或者按上限截断)，规模以实际跑的 r.n 为准
+            const seen = points.get(r.name) || [],
+                row = {
+                    name: r.name, n: r.n, sweepN: n, median: r.median, p95: r.p95, mean: r.mean, sd: r.sd,
+                    ciLow: r.ci95[0], ciHigh: r.ci95[1], nsPerOp: r.median * 1e6 / r.n,
+                }
+            // r.n 没有跟着这一档变大的点不参与拟合，在 CSV/JSON 里标为 fixed
+            if (seen.length && r.n <= seen[seen.length - 1].n) {
+                row.fixed = true
+                fixed.add(r.name)
+            } else {
+                seen.push(row)
+                points.set(r.name, seen)
+            }
+            rows.push(row)
+            latest.set(r.name, row)
+        }
+    }
+    const fits = []
+    for (const [name, p] of points) {
+        fits.push(Object.assign({ name, maxN: p[p.length - 1].n, fixed: fixed.has(name) }, fit(p)))
+    }
+    return { rows, fits }
+}
+
+function toCSV(rows) {
+    const cols = ['name', 'n', 'sweepN', 'median', 'p95', 'mean', 'sd', 'ciLow', 'ciHigh', 'nsPerOp', 'fixed', 'skipped']
+    const lines = [cols.join(',')]
+    for (const r of rows) {
+        lines.push(cols.map(c => r[c] === undefined ? '' : c == 'name' ? JSON.stringify(r[c]) : r[c]).join(','))
+    }
+    return lines.join('\n')
+}
+
+function printFits(fits) {
+    for (const f of fits) {
+        const slope = isNaN(f.slope) ? '?' : f.slope.toFixed(2),
+            note = f.fixed ? ', larger sweep sizes ran at a fixed n and are not fitted' : ''
+        console.log(`${f.name}: slope ${slope} total ${f.total} per op ${f.perOp} (up to n=${f.maxN}${note})`)
+    }
+}
+
+if (typeof module !== 'undefined') {
+    module.exports = { sweep, sizes, fit, toCSV, printFits }
+    if (require.main === module) {
+        const fs = require('fs'),
+            cli = require('./cli'),
+            args = cli.parseArgs(process.argv.slice(2)),
+            suite = cli.loadSuite(args._[0])
+        const options = {}
+        for (const k of ['from', 'to', 'steps', 'caseLimit']) {
+            if (args[k] !== undefined) options[k] = +args[k]
+        }
+        sweep(suite.register, options).then(({ rows, fits }) => {
+            printFits(fits)
+            if (args.csv) fs.writeFileSync(args.csv, toCSV(rows) + '\n')
+            if (args.json) cli.writeJSON(args.json, { env: harness.environment(), rows, fits })
+            if (!args.csv && !args.json) console.log(toCSV(rows))
+        })
+    }
+}
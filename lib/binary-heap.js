@@ -0,0 +1,235 @@
+/**
+ * 优先队列。代替"push 之后 sort 再 shift"的数组写法：push/pop O(log n)，peek O(1)。
+ * BinaryHeap 存任意对象，按 compare 排序，用 Map 记住每个元素的位置以支持 decreaseKey；
+ * QuadHeap 是 4 叉堆，元素是非负整数 id，优先级存在 Float64Array 里、位置存在 Int32Array 里，
+ * 树更矮、一次比较相邻的4个子节点，缓存更友好，也没有对象和 Map 的开销。
+ *
+ * @author KotoriK
+ */
+class BinaryHeap {
+    /**
+     * @param {(a: any, b: any) => number} [compare] 小于0表示 a 先出队，默认数值小顶堆
+     */
+    constructor(compare = (a, b) => a - b) {
+        this.compare = compare
+        this.heap = []
+        this.positions = new Map()
+    }
+
+    get size() {
+        return this.heap.length
+    }
+
+    push(value) {
+        this.heap.push(value)
+        this.positions.set(value, this.heap.length - 1)
+        this.up(this.heap.length - 1)
+        return this.heap.length
+    }
+
+    peek() {
+        return this.heap[0]
+    }
+
+    pop() {
+        const heap = this.heap
+        if (heap.length == 0) return undefined
+        const top = heap[0],
+            last = heap.pop()
+        this.positions.delete(top)
+        if (heap.length) {
+            heap[0] = last
+            this.positions.set(last, 0)
+            this.down(0)
+        }
+        return top
+    }
+
+    has(value) {
+        return this.positions.has(value)
+    }
+
+    /**
+     * value 的优先级被调高(比如 task.priority 改小了)之后调用，把它往上调整
+     *
+     * @returns {boolean} value 不在堆里时返回 false
+     */
+    decreaseKey(value) {
+        const i = this.positions.get(value)
+        if (i === undefined) return false
+        this.up(i)
+        return true
+    }
+
+    clear() {
+        this.heap.length = 0
+        this.positions.clear()
+    }
+
+    up(i) {
+        const heap = this.heap,
+            value = heap[i]
+        while (i > 0) {
+            const parent = (i - 1) >> 1
+            if (this.compare(value, heap[parent]) >= 0) break
+            heap[i] = heap[parent]
+            this.positions.set(heap[i], i)
+            i = parent
+        }
+        heap[i] = value
+        this.positions.set(value, i)
+    }
+
+    down(i) {
+        const heap = this.heap,
+            n = heap.length,
+            value = heap[i]
+        for (;;) {
+            let child = 2 * i + 1
+            if (child >= n) break
+            if (child + 1 < n && this.compare(heap[child + 1], heap[child]) < 0) child++
+            if (this.compare(heap[child], value) >= 0) break
+            heap[i] = heap[child]
+            this.positions.set(heap[i], i)
+            i = child
+        }
+        heap[i] = value
+        this.positions.set(value, i)
+    }
+}
+
+class QuadHeap {
+    /**
+     * @param {number} [capacity] 初始容量，满了翻倍
+     */
+    constructor(capacity = 16) {
+        this.ids = new Int32Array(Math.max(1, capacity))
+        this.priorities = new Float64Array(this.ids.length)
+        // id → 在堆里的下标，-1 表示不在堆里
+        this.positions = new Int32Array(this.ids.length).fill(-1)
+        this.length = 0
+    }
+
+    get size() {
+        return this.length
+    }
+
+    grow(capacity) {
+        const ids = new Int32Array(capacity),
+            priorities = new Float64Array(capacity)
+        ids.set(this.ids.subarray(0, this.length))
+        priorities.set(this.priorities.subarray(0, this.length))
+        this.ids = ids
+        this.priorities = priorities
+    }
+
+    growPositions(id) {
+        let cap = this.positions.length
+        while (cap <= id) cap *= 2
+        const positions = new Int32Array(cap).fill(-1)
+        positions.set(this.positions)
+        this.positions = positions
+    }
+
+    /**
+     * @param {number} id 非负整数，同一个 id 不能重复入堆
+     * @param {number} priority 越小越先出队
+     */
+    push(id, priority) {
+        if (this.length == this.ids.length) this.grow(this.length * 2)
+        if (id >= this.positions.length) this.growPositions(id)
+        this.up(this.length++, id, priority)
+        return this.length
+    }
+
+    peek() {
+        return this.length == 0 ? undefined : this.ids[0]
+    }
+
+    peekPriority() {
+        return this.length == 0 ? undefined : this.priorities[0]
+    }
+
+    pop() {
+        if (this.length == 0) return undefined
+        const top = this.ids[0]
+        this.positions[top] = -1
+        const n = --this.length
+        if (n) this.down(0, this.ids[n], this.priorities[n])
+        return top
+    }
+
+    has(id) {
+        return id < this.positions.length && this.positions[id] != -1
+    }
+
+    priorityOf(id) {
+        return this.has(id) ? this.priorities[this.positions[id]] : undefined
+    }
+
+    /**
+     * 把 id 的优先级改小。新的优先级不小于原来的时什么都不做
+     *
+     * @returns {boolean} id 不在堆里时返回 false
+     */
+    decreaseKey(id, priority) {
+        if (!this.has(id)) return false
+        const i = this.positions[id]
+        if (priority < this.priorities[i]) this.up(i, id, priority)
+        return true
+    }
+
+    clear() {
+        for (let i = 0; i < this.length; i++) {
+            this.positions[this.ids[i]] = -1
+        }
+        this.length = 0
+    }
+
+    // 把 (id, priority) 放到下标 i，再往上调整
+    up(i, id, priority) {
+        const ids = this.ids,
+            priorities = this.priorities,
+            positions = this.positions
+        while (i > 0) {
+            const parent = (i - 1) >> 2
+            if (priority >= priorities[parent]) break
+            ids[i] = ids[parent]
+            priorities[i] = priorities[parent]
+            positions[ids[i]] = i
+            i = parent
+        }
+        ids[i] = id
+        priorities[i] = priority
+        positions[id] = i
+    }
+
+    // 把 (id, priority) 放到下标 i，再往下调整
+    down(i, id, priority) {
+        const ids = this.ids,
+            priorities = this.priorities,
+            positions = this.positions,
+            n = this.length
+        for (;;) {
+            const first = 4 * i + 1
+            if (first >= n) break
+            let child = first
+            const end = Math.min(first + 4, n)
+            for (let c = first + 1; c < end; c++) {
+                if (priorities[c] < priorities[child]) child = c
+            }
+            if (priorities[child] >= priority) break
+            ids[i] = ids[child]
+            priorities[i] = priorities[child]
+            positions[ids[i]] = i
+            i = child
+        }
+        ids[i] = id
+        priorities[i] = priority
+        positions[id] = i
+    }
+}
+
+if (typeof module !== 'undefined') {
+    module.exports = { BinaryHeap, QuadHeap }
+}
@@ -0,0 +1,135 @@
+/**
+ * 分块链表实现的双端队列。每块固定大小，两端满了只挂一个新块，不会像 RingQueue 翻倍时整体复制，
+ * 单次操作的最坏延迟是常数。空出来的块放进空闲池，下次扩展时复用。
+ *
+ * @author KotoriK
+ */
+class Chunk {
+    constructor(size, ArrayType) {
+        this.items = new ArrayType(size)
+        this.prev = null
+        this.next = null
+    }
+}
+
+class ChunkDeque {
+    /**
+     * @param {number} [chunkSize] 每块的元素数
+     * @param {Function} [ArrayType] 块的存储类型，默认 Array，数值可用 TypedArray
+     * @param {number} [poolSize] 空闲池最多保留的块数
+     */
+    constructor(chunkSize = 1024, ArrayType = Array, poolSize = 16) {
+        this.chunkSize = chunkSize
+        this.ArrayType = ArrayType
+        this.typed = ArrayType.BYTES_PER_ELEMENT > 0
+        this.poolSize = poolSize
+        this.pool = []
+        this.head = this.tail = new Chunk(chunkSize, ArrayType)
+        this.headIndex = this.tailIndex = chunkSize >> 1
+        this.length = 0
+    }
+
+    alloc() {
+        return this.pool.length ? this.pool.pop() : new Chunk(this.chunkSize, this.ArrayType)
+    }
+
+    release(chunk) {
+        if (this.pool.length >= this.poolSize) return
+        chunk.prev = chunk.next = null
+        this.pool.push(chunk)
+    }
+
+    // 清空后回到单块、下标居中的状态，两端都留出空间
+    reset() {
+        while (this.head !== this.tail) {
+            const next = this.head.next
+            this.release(this.head)
+            this.head = next
+        }
+        this.head.prev = this.head.next = null
+        this.headIndex = this.tailIndex = this.chunkSize >> 1
+    }
+
+    push(value) {
+        if (this.tailIndex == this.chunkSize) {
+            const chunk = this.alloc()
+            chunk.prev = this.tail
+            this.tail.next = chunk
+            this.tail = chunk
+            this.tailIndex = 0
+        }
+        this.tail.items[this.tailIndex++] = value
+        return ++this.length
+    }
+
+    unshift(value) {
+        if (this.headIndex == 0) {
+            const chunk = this.alloc()
+            chunk.next = this.head
+            this.head.prev = chunk
+            this.head = chunk
+            this.headIndex = this.chunkSize
+        }
+        this.head.items[--this.headIndex] = value
+        return ++this.length
+    }
+
+    shift() {
+        if (this.length == 0) return undefined
+        const items = this.head.items,
+            value = items[this.headIndex]
+        if (!this.typed) items[this.headIndex] = undefined
+        this.headIndex++
+        if (--this.length == 0) {
+            this.reset()
+        } else if (this.headIndex == this.chunkSize) {
+            const old = this.head
+            this.head = old.next
+            this.head.prev = null
+            this.headIndex = 0
+            this.release(old)
+        }
+        return value
+    }
+
+    pop() {
+        if (this.length == 0) return undefined
+        const items = this.tail.items,
+            value = items[--this.tailIndex]
+        if (!this.typed) items[this.tailIndex] = undefined
+        if (--this.length == 0) {
+            this.reset()
+        } else if (this.tailIndex == 0) {
+            const old = this.tail
+            this.tail = old.prev
+            this.tail.next = null
+            this.tailIndex = this.chunkSize
+            this.release(old)
+        }
+        return value
+    }
+
+    peekFirst() {
+        return this.length == 0 ? undefined : this.head.items[this.headIndex]
+    }
+
+    peekLast() {
+        return this.length == 0 ? undefined : this.tail.items[this.tailIndex - 1]
+    }
+
+    *[Symbol.iterator]() {
+        let chunk = this.head,
+            i = this.headIndex
+        for (let left = this.length; left > 0; left--) {
+            if (i == this.chunkSize) {
+                chunk = chunk.next
+                i = 0
+            }
+            yield chunk.items[i++]
+        }
+    }
+}
+
+if (typeof module !== 'undefined') {
+    module.exports = { ChunkDeque }
+}
@@ -0,0 +1,106 @@
+/**
+ * HTMLElement 对象池。预先创建一批元素，acquire 取出、release 归还时重置状态再复用，
+ * 省掉 createElement 的开销。
+ * 监听器请用 pool.signal(el) 注册({ signal })，归还时统一 abort 掉；
+ * 媒体元素归还时 pause、去掉 src 再 load()，让它放掉已经加载的资源。
+ * 同一个元素重复归还时忽略，免得之后被借给两个地方。
+ *
+ * @author KotoriK
+ */
+class ElementPool {
+    /**
+     * @param {string} tagName
+     * @param {object} [options]
+     * @param {number} [options.size] 预创建的数量
+     * @param {number} [options.max] 空闲元素最多保留多少，多出来的直接丢给GC
+     * @param {Document} [options.document]
+     * @param {(el: Element) => void} [options.reset] 额外的重置逻辑，在默认重置之后调用
+     */
+    constructor(tagName, options = {}) {
+        this.tagName = tagName
+        this.document = options.document || document
+        this.max = options.max === undefined ? Infinity : options.max
+        this.resetHook = options.reset
+        this.free = []
+        // 空闲列表里的元素，用来识别重复归还
+        this.pooled = new Set()
+        this.controllers = new Map()
+        this.created = 0
+        this.reused = 0
+        this.reserve(options.size || 0)
+    }
+
+    /**
+     * 补足空闲元素到 count 个
+     */
+    reserve(count) {
+        while (this.free.length < count) {
+            const el = this.document.createElement(this.tagName)
+            this.free.push(el)
+            this.pooled.add(el)
+            this.created++
+        }
+    }
+
+    acquire() {
+        if (this.free.length) {
+            this.reused++
+            const el = this.free.pop()
+            this.pooled.delete(el)
+            return el
+        }
+        this.created++
+        return this.document.createElement(this.tagName)
+    }
+
+    /**
+     * 这次借出期间注册监听器用的 signal
+     *
+     * @param {Element} el
+     */
+    signal(el) {
+        let controller = this.controllers.get(el)
+        if (!controller) {
+            controller = new AbortController()
+            this.controllers.set(el, controller)
+        }
+        return controller.signal
+    }
+
+    reset(el) {
+        const controller = this.controllers.get(el)
+        if (controller) {
+            controller.abort()
+            this.controllers.delete(el)
+        }
+        if (el.parentNode) el.parentNode.removeChild(el)
+        const media = typeof el.load === 'function' && el.hasAttribute('src')
+        if (media) el.pause()
+        while (el.attributes.length) {
+            el.removeAttribute(el.attributes[0].name)
+        }
+        if (media) el.load()
+        if (this.resetHook) this.resetHook(el)
+    }
+
+    /**
+     * @returns {boolean} el 已经在池子里(重复归还)时返回 false，不做任何事
+     */
+    release(el) {
+        if (this.pooled.has(el)) return false
+        this.reset(el)
+        if (this.free.length < this.max) {
+            this.free.push(el)
+            this.pooled.add(el)
+        }
+        return true
+    }
+
+    get idle() {
+        return this.free.length
+    }
+}
+
+if (typeof module !== 'undefined') {
+    module.exports = { ElementPool }
+}
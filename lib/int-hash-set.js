@@ -0,0 +1,262 @@
+/**
+ * 只存 int32 的开放寻址哈希集合，键放在 Int32Array 里。
+ * IntHashSet 用线性探测，RobinHoodIntSet 用 Robin Hood 探测(探测距离短的让位给长的，查找未命中可以提前结束)。
+ * 两者删除都用反向移位把后面的键挪回来，不留墓碑，探测链不会越删越长。
+ * 装载超过 maxLoad 翻倍，删到上限的 1/4 以下减半。
+ *
+ * @author KotoriK
+ */
+const EMPTY = -2147483648
+
+// Fibonacci 哈希，取乘积的高 bits 位
+function fib(key, bits) {
+    return Math.imul(key, 0x9E3779B1) >>> (32 - bits)
+}
+
+function bitsFor(capacity, maxLoad) {
+    let bits = 2
+    while ((1 << bits) * maxLoad < capacity) bits++
+    return bits
+}
+
+/**
+ * 线性探测。INT32_MIN 用作空槽标记，它本身单独用一个标志位存。
+ */
+class IntHashSet {
+    /**
+     * @param {number} [capacity] 预计元素数
+     * @param {number} [maxLoad] 装载因子上限，超过就翻倍重建
+     */
+    constructor(capacity = 16, maxLoad = 0.5) {
+        this.maxLoad = maxLoad
+        this.hasEmptyKey = false
+        this.size = 0
+        this.minBits = bitsFor(capacity, maxLoad)
+        this.alloc(this.minBits)
+    }
+
+    alloc(bits) {
+        this.bits = bits
+        this.mask = (1 << bits) - 1
+        this.keys = new Int32Array(1 << bits).fill(EMPTY)
+        this.used = 0
+        this.limit = Math.floor((1 << bits) * this.maxLoad)
+    }
+
+    slot(key) {
+        return fib(key, this.bits)
+    }
+
+    add(key) {
+        key |= 0
+        if (key == EMPTY) {
+            if (!this.hasEmptyKey) {
+                this.hasEmptyKey = true
+                this.size++
+            }
+            return this
+        }
+        const keys = this.keys,
+            mask = this.mask
+        let i = this.slot(key)
+        while (keys[i] != EMPTY) {
+            if (keys[i] == key) return this
+            i = (i + 1) & mask
+        }
+        keys[i] = key
+        this.size++
+        if (++this.used > this.limit) this.rehash(this.bits + 1)
+        return this
+    }
+
+    has(key) {
+        key |= 0
+        if (key == EMPTY) return this.hasEmptyKey
+        const keys = this.keys,
+            mask = this.mask
+        for (let i = this.slot(key); keys[i] != EMPTY; i = (i + 1) & mask) {
+            if (keys[i] == key) return true
+        }
+        return false
+    }
+
+    delete(key) {
+        key |= 0
+        if (key == EMPTY) {
+            if (!this.hasEmptyKey) return false
+            this.hasEmptyKey = false
+            this.size--
+            return true
+        }
+        const keys = this.keys,
+            mask = this.mask
+        let i = this.slot(key)
+        while (keys[i] != key) {
+            if (keys[i] == EMPTY) return false
+            i = (i + 1) & mask
+        }
+        // 往后找能填进空位 i 的键：它的理想位置不在 (i, j] 之间
+        for (let j = (i + 1) & mask; keys[j] != EMPTY; j = (j + 1) & mask) {
+            const home = this.slot(keys[j])
+            if (i <= j ? (i < home && home <= j) : (i < home || home <= j)) continue
+            keys[i] = keys[j]
+            i = j
+        }
+        keys[i] = EMPTY
+        this.size--
+        if (--this.used < this.limit >> 2 && this.bits > this.minBits) this.rehash(this.bits - 1)
+        return true
+    }
+
+    rehash(bits) {
+        const old = this.keys
+        this.alloc(bits)
+        const keys = this.keys,
+            mask = this.mask
+        for (let k = 0; k < old.length; k++) {
+            const key = old[k]
+            if (key == EMPTY) continue
+            let i = this.slot(key)
+            while (keys[i] != EMPTY) i = (i + 1) & mask
+            keys[i] = key
+            this.used++
+        }
+    }
+
+    clear() {
+        this.keys.fill(EMPTY)
+        this.used = 0
+        this.size = 0
+        this.hasEmptyKey = false
+    }
+
+    *values() {
+        if (this.hasEmptyKey) yield EMPTY
+        for (const key of this.keys) {
+            if (key != EMPTY) yield key
+        }
+    }
+
+    [Symbol.iterator]() {
+        return this.values()
+    }
+}
+
+/**
+ * Robin Hood 探测。dist 记录每个槽的探测距离+1，0 表示空槽，所以任何 int32 都能存。
+ * 距离超过255时直接扩容。
+ */
+class RobinHoodIntSet {
+    /**
+     * @param {number} [capacity] 预计元素数
+     * @param {number} [maxLoad] 装载因子上限，Robin Hood 在高装载下也能保持短探测链
+     */
+    constructor(capacity = 16, maxLoad = 0.75) {
+        this.maxLoad = maxLoad
+        this.size = 0
+        this.minBits = bitsFor(capacity, maxLoad)
+        this.alloc(this.minBits)
+    }
+
+    alloc(bits) {
+        this.bits = bits
+        this.mask = (1 << bits) - 1
+        this.keys = new Int32Array(1 << bits)
+        this.dist = new Uint8Array(1 << bits)
+        this.limit = Math.floor((1 << bits) * this.maxLoad)
+    }
+
+    has(key) {
+        key |= 0
+        const keys = this.keys,
+            dist = this.dist,
+            mask = this.mask
+        for (let i = fib(key, this.bits), d = 1; dist[i] >= d; i = (i + 1) & mask, d++) {
+            if (keys[i] == key) return true
+        }
+        return false
+    }
+
+    add(key) {
+        key |= 0
+        if (this.has(key)) return this
+        this.size++
+        if (this.size > this.limit) this.rehash(this.bits + 1)
+        this.place(key)
+        return this
+    }
+
+    // 插入一个确定不存在的键，沿途把探测距离更短的键换出来继续往后放
+    place(key) {
+        const keys = this.keys,
+            dist = this.dist,
+            mask = this.mask
+        let i = fib(key, this.bits), d = 1
+        while (dist[i] != 0) {
+            if (dist[i] < d) {
+                const k = keys[i], e = dist[i]
+                keys[i] = key
+                dist[i] = d
+                key = k
+                d = e
+            }
+            i = (i + 1) & mask
+            if (++d > 255) {
+                this.rehash(this.bits + 1)
+                this.place(key)
+                return
+            }
+        }
+        keys[i] = key
+        dist[i] = d
+    }
+
+    delete(key) {
+        key |= 0
+        const keys = this.keys,
+            dist = this.dist,
+            mask = this.mask
+        let i = fib(key, this.bits), d = 1
+        while (keys[i] != key || dist[i] == 0) {
+            if (dist[i] < d) return false
+            i = (i + 1) & mask
+            d++
+        }
+        for (let j = (i + 1) & mask; dist[j] > 1; j = (j + 1) & mask) {
+            keys[i] = keys[j]
+            dist[i] = dist[j] - 1
+            i = j
+        }
+        dist[i] = 0
+        if (--this.size < this.limit >> 2 && this.bits > this.minBits) this.rehash(this.bits - 1)
+        return true
+    }
+
+    rehash(bits) {
+        const keys = this.keys,
+            dist = this.dist
+        this.alloc(bits)
+        for (let k = 0; k < keys.length; k++) {
+            if (dist[k] != 0) this.place(keys[k])
+        }
+    }
+
+    clear() {
+        this.dist.fill(0)
+        this.size = 0
+    }
+
+    *values() {
+        for (let k = 0; k < this.keys.length; k++) {
+            if (this.dist[k] != 0) yield this.keys[k]
+        }
+    }
+
+    [Symbol.iterator]() {
+        return this.values()
+    }
+}
+
+if (typeof module !== 'undefined') {
+    module.exports = { IntHashSet, RobinHoodIntSet }
+}
@@ -0,0 +1,60 @@
+/**
+ * 按 Blob 引用计数的 object URL 缓存。同一个 Blob 只生成一个 URL，
+ * 最后一个使用者 release 时才 revokeObjectURL，Blob 不会因为忘了 revoke 一直被钉在内存里。
+ *
+ * @author KotoriK
+ */
+class ObjectURLCache {
+    constructor() {
+        this.entries = new Map()
+        this.owners = new Map()
+    }
+
+    /**
+     * 取 blob 的 URL，引用数+1
+     *
+     * @param {Blob} blob
+     * @returns {string}
+     */
+    acquire(blob) {
+        let entry = this.entries.get(blob)
+        if (!entry) {
+            entry = { url: URL.createObjectURL(blob), refs: 0 }
+            this.entries.set(blob, entry)
+            this.owners.set(entry.url, blob)
+        }
+        entry.refs++
+        return entry.url
+    }
+
+    /**
+     * 引用数-1，归零时 revoke。不是本缓存发出的 URL 返回 false
+     *
+     * @param {string} url
+     */
+    release(url) {
+        const blob = this.owners.get(url)
+        if (!blob) return false
+        const entry = this.entries.get(blob)
+        if (--entry.refs == 0) {
+            URL.revokeObjectURL(url)
+            this.entries.delete(blob)
+            this.owners.delete(url)
+        }
+        return true
+    }
+
+    get size() {
+        return this.entries.size
+    }
+
+    clear() {
+        for (const url of this.owners.keys()) URL.revokeObjectURL(url)
+        this.entries.clear()
+        this.owners.clear()
+    }
+}
+
+if (typeof module !== 'undefined') {
+    module.exports = { ObjectURLCache }
+}
@@ -0,0 +1,128 @@
+/**
+ * 按插入顺序可下标访问的 Set。Map 记录 值→下标，另有一个稠密数组按顺序存值，
+ * 所以 last()/nth() 不用像原生 Set 那样从头迭代。
+ * delete 打墓碑保持顺序，墓碑超过存活元素数时整体压缩，均摊 O(1)；
+ * 不在乎顺序时用 swapDelete，把末尾元素换到被删位置，严格 O(1)。
+ * 有墓碑时 nth/first 要先压缩一次，是 O(n)；delete 和 nth 交替调用的话每次都是 O(n)，这种用法请改用 swapDelete。
+ *
+ * @author KotoriK
+ */
+const HOLE = Symbol('hole')
+
+class OrderedSet {
+    constructor(iterable) {
+        this.index = new Map()
+        this.dense = []
+        this.holes = 0
+        if (iterable) {
+            for (const value of iterable) this.add(value)
+        }
+    }
+
+    get size() {
+        return this.index.size
+    }
+
+    add(value) {
+        if (!this.index.has(value)) {
+            this.index.set(value, this.dense.length)
+            this.dense.push(value)
+        }
+        return this
+    }
+
+    has(value) {
+        return this.index.has(value)
+    }
+
+    delete(value) {
+        const i = this.index.get(value)
+        if (i === undefined) return false
+        this.index.delete(value)
+        if (i == this.dense.length - 1) {
+            this.dense.pop()
+            this.trim()
+        } else {
+            this.dense[i] = HOLE
+            if (++this.holes > 16 && this.holes > this.index.size) this.compact()
+        }
+        return true
+    }
+
+    // trim() 保证末尾总是存活元素，直接拿它填到被删的位置，不用压缩
+    swapDelete(value) {
+        const i = this.index.get(value)
+        if (i === undefined) return false
+        this.index.delete(value)
+        const moved = this.dense.pop()
+        if (i < this.dense.length) {
+            this.dense[i] = moved
+            this.index.set(moved, i)
+        }
+        this.trim()
+        return true
+    }
+
+    // 去掉末尾的墓碑，保证 dense 的最后一个是存活元素
+    trim() {
+        const dense = this.dense
+        while (dense.length && dense[dense.length - 1] === HOLE) {
+            dense.pop()
+            this.holes--
+        }
+    }
+
+    compact() {
+        const dense = this.dense
+        let j = 0
+        for (let i = 0; i < dense.length; i++) {
+            const value = dense[i]
+            if (value === HOLE) continue
+            if (i != j) {
+                dense[j] = value
+                this.index.set(value, j)
+            }
+            j++
+        }
+        dense.length = j
+        this.holes = 0
+    }
+
+    /**
+     * 第 k 个(按插入顺序)元素。没有墓碑时 O(1)；有墓碑时先压缩，O(n)
+     *
+     * @param {number} k
+     */
+    nth(k) {
+        if (this.holes) this.compact()
+        return this.dense[k]
+    }
+
+    first() {
+        return this.nth(0)
+    }
+
+    last() {
+        return this.dense[this.dense.length - 1]
+    }
+
+    clear() {
+        this.index.clear()
+        this.dense.length = 0
+        this.holes = 0
+    }
+
+    *values() {
+        for (const value of this.dense) {
+            if (value !== HOLE) yield value
+        }
+    }
+
+    [Symbol.iterator]() {
+        return this.values()
+    }
+}
+
+if (typeof module !== 'undefined') {
+    module.exports = { OrderedSet }
+}
@@ -0,0 +1,80 @@
+/**
+ * 环形缓冲区实现的队列，容量为2的幂，满了翻倍。push/shift 均摊 O(1)，可以直接替换当队列用的数组。
+ * 传入 TypedArray 构造函数(如 Int32Array)时用类型化数组存储数值，省掉装箱。
+ *
+ * @author KotoriK
+ */
+class RingQueue {
+    /**
+     * @param {number} [capacity] 初始容量，会向上取到2的幂
+     * @param {Function} [ArrayType] 存储用的构造函数，默认 Array
+     */
+    constructor(capacity = 16, ArrayType = Array) {
+        let cap = 2
+        while (cap < capacity) cap <<= 1
+        this.ArrayType = ArrayType
+        this.typed = ArrayType.BYTES_PER_ELEMENT > 0
+        this.buffer = new ArrayType(cap)
+        this.mask = cap - 1
+        this.head = 0
+        this.length = 0
+    }
+
+    get capacity() {
+        return this.mask + 1
+    }
+
+    grow() {
+        const old = this.buffer,
+            cap = old.length,
+            buffer = new this.ArrayType(cap * 2),
+            head = this.head
+        if (this.typed) {
+            buffer.set(old.subarray(head))
+            buffer.set(old.subarray(0, head), cap - head)
+        } else {
+            for (let i = 0; i < cap; i++) {
+                buffer[i] = old[(head + i) & this.mask]
+            }
+        }
+        this.buffer = buffer
+        this.mask = cap * 2 - 1
+        this.head = 0
+    }
+
+    push(value) {
+        if (this.length > this.mask) this.grow()
+        this.buffer[(this.head + this.length) & this.mask] = value
+        return ++this.length
+    }
+
+    shift() {
+        if (this.length == 0) return undefined
+        const buffer = this.buffer,
+            value = buffer[this.head]
+        if (!this.typed) buffer[this.head] = undefined
+        this.head = (this.head + 1) & this.mask
+        this.length--
+        return value
+    }
+
+    peek() {
+        return this.length == 0 ? undefined : this.buffer[this.head]
+    }
+
+    clear() {
+        if (!this.typed) this.buffer.fill(undefined)
+        this.head = 0
+        this.length = 0
+    }
+
+    *[Symbol.iterator]() {
+        for (let i = 0; i < this.length; i++) {
+            yield this.buffer[(this.head + i) & this.mask]
+        }
+    }
+}
+
+if (typeof module !== 'undefined') {
+    module.exports = { RingQueue }
+}
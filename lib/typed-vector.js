@@ -0,0 +1,81 @@
+/**
+ * 基于 TypedArray 的可增长向量，容量不够时翻倍(均摊 O(1))，也可以用 reserve 预留容量。
+ * 存小整数时比普通数组省内存，也没有元素种类退化的问题。
+ *
+ * @author KotoriK
+ */
+class TypedVector {
+    /**
+     * @param {Function} [ArrayType] 如 Int32Array、Float64Array
+     * @param {number} [capacity] 初始容量
+     */
+    constructor(ArrayType = Int32Array, capacity = 16) {
+        this.ArrayType = ArrayType
+        this.data = new ArrayType(Math.max(1, capacity))
+        this.length = 0
+    }
+
+    get capacity() {
+        return this.data.length
+    }
+
+    /**
+     * 保证容量至少为 capacity，只会扩大
+     *
+     * @param {number} capacity
+     */
+    reserve(capacity) {
+        if (capacity <= this.data.length) return
+        const data = new this.ArrayType(capacity)
+        data.set(this.data.subarray(0, this.length))
+        this.data = data
+    }
+
+    push(value) {
+        if (this.length == this.data.length) this.reserve(this.data.length * 2)
+        this.data[this.length] = value
+        return ++this.length
+    }
+
+    pop() {
+        return this.length == 0 ? undefined : this.data[--this.length]
+    }
+
+    get(i) {
+        return i < this.length ? this.data[i] : undefined
+    }
+
+    /**
+     * 下标写入，超出长度时自动扩展，中间补0，相当于 d[i] = v
+     */
+    set(i, value) {
+        if (i >= this.length) {
+            if (i >= this.data.length) this.reserve(Math.max(i + 1, this.data.length * 2))
+            this.length = i + 1
+        }
+        this.data[i] = value
+    }
+
+    last() {
+        return this.length == 0 ? undefined : this.data[this.length - 1]
+    }
+
+    clear() {
+        this.length = 0
+    }
+
+    /**
+     * 当前内容的视图，不复制
+     */
+    view() {
+        return this.data.subarray(0, this.length)
+    }
+
+    [Symbol.iterator]() {
+        return this.view()[Symbol.iterator]()
+    }
+}
+
+if (typeof module !== 'undefined') {
+    module.exports = { TypedVector }
+}